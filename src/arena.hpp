@@ -97,6 +97,12 @@ public:
   // explicitly copied to 'to' with 'copy' becomes invalid.
   //
   void swap ();
+
+  // Allocated bytes of both spaces.
+  //
+  size_t bytes () const {
+    return (from.end - from.start) + (to.end - to.start);
+  }
 };
 
 } // namespace CaDiCaL
@@ -7,7 +7,10 @@ namespace CaDiCaL {
 // adds an assumption literal onto the assumption stack.
 
 void Internal::assume (int lit) {
-  if (level && !opts.ilbassumptions)
+  if (opts.satsolvermode == 1) { // circuit values and suspended watches
+    if (level)
+      circuit_backtrack ();
+  } else if (level && !opts.ilbassumptions)
     backtrack ();
   else if (val (lit) < 0)
     backtrack (max (0, var (lit).level - 1));
@@ -55,6 +55,10 @@ class App : public Handler, public Terminator {
   void print_usage (bool all = false);
   void print_witness (FILE *);
 
+  // Server mode answering queries on the parsed circuit.
+  //
+  int serve (bool witness, int conflict_limit, int decision_limit);
+
 #ifndef QUIET
   void signal_message (const char *msg, int sig);
 #endif
@@ -146,6 +150,20 @@ void App::print_usage (bool all) {
         "\n"
         "  -o <output>    write simplified CNF in DIMACS format to file\n"
         "  -e <extend>    write reconstruction/extension stack to file\n"
+        "  -a <output>    write CNF encoding of AAG input in DIMACS format\n"
+        "                 to file (see '--circuitcnf')\n"
+        "  -k <ckpt>      write circuit solver checkpoints to file and\n"
+        "                 resume from it if it exists (see '--circuitckptint')\n"
+        "  -m <cache>     import and store learned lemmas of the circuit\n"
+        "                 engine in a persistent lemma cache file\n"
+        "  -g <hints>     seed circuit engine decisions with per-node scores,\n"
+        "                 phases and priorities read from file\n"
+        "  -x <aig>       write simplified circuit with node map in AIGER\n"
+        "                 format to file (binary if it ends with '.aig')\n"
+        "  -s <cubes>     enumerate cubes of input patterns satisfying the\n"
+        "                 AAG to file (see below and '--circuitenum')\n"
+        "  --server       load AAG once and answer queries read from\n"
+        "                 '<stdin>' (see below)\n"
 #ifdef LOGGING
         "  -l             enable logging messages (same as '--log')\n"
 #endif
@@ -236,6 +254,25 @@ void App::print_usage (bool all) {
         "prints the standard unsatisfiable solution line ('s "
         "UNSATISFIABLE').\n"
         "\n"
+        "In server mode ('--server') the circuit engine loads the AAG\n"
+        "once and then answers one query per line read from '<stdin>':\n"
+        "\n"
+        "  solve [ -c <limit> ] [ -d <limit> ] [ <lit> ... ]\n"
+        "  quit\n"
+        "\n"
+        "where '<lit>' is a signed node (AIGER variable) assumed for this\n"
+        "query.  Outputs are not asserted but can be assumed.  Learned\n"
+        "gates are kept across queries.  Each query is answered by an\n"
+        "'s SATISFIABLE' line with witness, 's UNSATISFIABLE' or, if a\n"
+        "limit was hit, 's UNKNOWN', and invalid queries by an 'e' line.\n"
+        "\n"
+        "With '-s' all input patterns satisfying the outputs of the AAG\n"
+        "are enumerated as cubes, one line per cube with '0', '1' or 'x'\n"
+        "(don't-care) for each input.  Each cube is blocked and the search\n"
+        "continues with learned gates kept.  The exit code is 20 if all\n"
+        "patterns are covered, 10 if the '--circuitenum' limit was reached\n"
+        "and 0 if interrupted by other limits.\n"
+        "\n"
         "By default the proof is stored in the binary DRAT format unless\n"
         "the option '--no-binary' is specified or the proof is written\n"
         "to  '<stdout>' and '<stdout>' is connected to a terminal.\n"
@@ -282,6 +319,93 @@ void App::print_witness (FILE *file) {
 
 /*------------------------------------------------------------------------*/
 
+// Answer queries read from '<stdin>' until 'quit' or end-of-file (see the
+// usage message for the protocol).  Each query is solved incrementally
+// under its assumptions, thus gates learned by earlier queries are kept.
+
+int App::serve (bool witness, int conflict_limit, int decision_limit) {
+  size_t queries = 0, satisfiable = 0, unsatisfiable = 0;
+  string line;
+  int ch;
+  for (;;) {
+    line.clear ();
+    while ((ch = getchar ()) != EOF && ch != '\n')
+      line += (char) ch;
+    if (line.empty () && ch == EOF)
+      break;
+    vector<string> tokens;
+    size_t pos = 0;
+    while ((pos = line.find_first_not_of (" \t\r", pos)) != string::npos) {
+      const size_t end = line.find_first_of (" \t\r", pos);
+      tokens.push_back (line.substr (pos, end - pos));
+      pos = end;
+    }
+    if (tokens.empty () || tokens[0][0] == 'c')
+      continue;
+    if (tokens[0] == "quit")
+      break;
+    if (tokens[0] != "solve") {
+      printf ("e unknown command '%s'\n", tokens[0].c_str ());
+      fflush (stdout);
+      continue;
+    }
+    int conflicts = conflict_limit, decisions = decision_limit;
+    vector<int> assumptions;
+    const char *error = 0;
+    for (size_t i = 1; !error && i < tokens.size (); i++) {
+      const char *token = tokens[i].c_str ();
+      int *limit = !strcmp (token, "-c")   ? &conflicts
+                   : !strcmp (token, "-d") ? &decisions
+                                           : 0;
+      int lit;
+      if (limit) {
+        if (++i == tokens.size () ||
+            !parse_int_str (tokens[i].c_str (), *limit) || *limit < 0)
+          error = "invalid limit";
+      } else if (!parse_int_str (token, lit) || !lit ||
+                 lit == INT_MIN || abs (lit) > max_var)
+        error = "invalid literal";
+      else
+        assumptions.push_back (lit);
+    }
+    if (error) {
+      printf ("e %s in '%s'\n", error, line.c_str ());
+      fflush (stdout);
+      continue;
+    }
+    for (const auto lit : assumptions)
+      solver->assume (lit);
+    if (conflicts >= 0)
+      (void) solver->limit ("conflicts", conflicts);
+    if (decisions >= 0)
+      (void) solver->limit ("decisions", decisions);
+    queries++;
+    const int res = solver->solve ();
+    if (res == 10) {
+      satisfiable++;
+      fputs ("s SATISFIABLE\n", stdout);
+      if (witness)
+        print_witness (stdout);
+    } else if (res == 20) {
+      unsatisfiable++;
+      fputs ("s UNSATISFIABLE\n", stdout);
+    } else
+      fputs ("s UNKNOWN\n", stdout);
+    fflush (stdout);
+    if (timesup)
+      break;
+  }
+  solver->section ("server summary");
+  solver->message ("%zu queries answered", queries);
+  solver->message ("%zu queries satisfiable %.0f%%", satisfiable,
+                   percent (satisfiable, queries));
+  solver->message ("%zu queries unsatisfiable %.0f%%", unsatisfiable,
+                   percent (unsatisfiable, queries));
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Wrapper around option setting.
 
 int App::get (const char *o) { return solver->get (o); }
@@ -370,7 +494,9 @@ int App::main (int argc, char **argv) {
   const char *dimacs_path = 0, *proof_path = 0;
   bool proof_specified = false, dimacs_specified = false;
   int optimize = 0, preprocessing = 0, localsearch = 0;
-  const char *output_path = 0, *extension_path = 0;
+  const char *output_path = 0, *extension_path = 0, *aag_cnf_path = 0;
+  const char *checkpoint_path = 0, *lemma_cache_path = 0, *hints_path = 0;
+  const char *export_path = 0, *enumerate_path = 0;
   int conflict_limit = -1, decision_limit = -1;
   const char *conflict_limit_specified = 0;
   const char *decision_limit_specified = 0;
@@ -378,7 +504,7 @@ int App::main (int argc, char **argv) {
 #ifndef __MINGW32__
   const char *time_limit_specified = 0;
 #endif
-  bool witness = true, less = false, status = true;
+  bool witness = true, less = false, status = true, server = false;
   const char *dimacs_name, *err;
 
   for (int i = 1; i < argc; i++) {
@@ -422,6 +548,69 @@ int App::main (int argc, char **argv) {
         APPERR ("output file '%s' not writable", argv[i]);
       else
         output_path = argv[i];
+    } else if (!strcmp (argv[i], "-a")) {
+      if (++i == argc)
+        APPERR ("argument to '-a' missing");
+      else if (aag_cnf_path)
+        APPERR ("multiple CNF encoding file options '-a %s' and '-a %s'",
+                aag_cnf_path, argv[i]);
+      else if (!force_writing && most_likely_existing_cnf_file (argv[i]))
+        APPERR ("CNF encoding file '%s' most likely existing CNF (use '-f')",
+                argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("CNF encoding file '%s' not writable", argv[i]);
+      else
+        aag_cnf_path = argv[i];
+    } else if (!strcmp (argv[i], "-k")) {
+      if (++i == argc)
+        APPERR ("argument to '-k' missing");
+      else if (checkpoint_path)
+        APPERR ("multiple checkpoint file options '-k %s' and '-k %s'",
+                checkpoint_path, argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("checkpoint file '%s' not writable", argv[i]);
+      else
+        checkpoint_path = argv[i];
+    } else if (!strcmp (argv[i], "-m")) {
+      if (++i == argc)
+        APPERR ("argument to '-m' missing");
+      else if (lemma_cache_path)
+        APPERR ("multiple lemma cache options '-m %s' and '-m %s'",
+                lemma_cache_path, argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("lemma cache '%s' not writable", argv[i]);
+      else
+        lemma_cache_path = argv[i];
+    } else if (!strcmp (argv[i], "-g")) {
+      if (++i == argc)
+        APPERR ("argument to '-g' missing");
+      else if (hints_path)
+        APPERR ("multiple hint file options '-g %s' and '-g %s'",
+                hints_path, argv[i]);
+      else if (!File::exists (argv[i]))
+        APPERR ("hint file '%s' does not exist", argv[i]);
+      else
+        hints_path = argv[i];
+    } else if (!strcmp (argv[i], "-x")) {
+      if (++i == argc)
+        APPERR ("argument to '-x' missing");
+      else if (export_path)
+        APPERR ("multiple circuit export options '-x %s' and '-x %s'",
+                export_path, argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("circuit export file '%s' not writable", argv[i]);
+      else
+        export_path = argv[i];
+    } else if (!strcmp (argv[i], "-s")) {
+      if (++i == argc)
+        APPERR ("argument to '-s' missing");
+      else if (enumerate_path)
+        APPERR ("multiple enumeration options '-s %s' and '-s %s'",
+                enumerate_path, argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("enumeration file '%s' not writable", argv[i]);
+      else
+        enumerate_path = argv[i];
     } else if (!strcmp (argv[i], "-e")) {
       if (++i == argc)
         APPERR ("argument to '-e' missing");
@@ -518,6 +707,8 @@ int App::main (int argc, char **argv) {
              !strcmp (argv[i], "--force=1") ||
              !strcmp (argv[i], "--force=true"))
       force_strict_parsing = 0, force_writing = true;
+    else if (!strcmp (argv[i], "--server"))
+      server = true;
     else if (!strcmp (argv[i], "--strict") ||
              !strcmp (argv[i], "--strict=1") ||
              !strcmp (argv[i], "--strict=true"))
@@ -578,6 +769,20 @@ int App::main (int argc, char **argv) {
     APPERR ("DIMACS input file '%s' does not exist", dimacs_path);
   if (read_solution_path && !File::exists (read_solution_path))
     APPERR ("solution file '%s' does not exist", read_solution_path);
+  if (server && !(dimacs_path && has_suffix (dimacs_path, ".aag")))
+    APPERR ("option '--server' requires an AAG input file");
+  if (server && proof_specified)
+    APPERR ("option '--server' does not support proofs");
+  if (server && (checkpoint_path || lemma_cache_path))
+    APPERR ("option '--server' can not be combined with '-k' or '-m' "
+            "(outputs are not asserted in server mode)");
+  if (enumerate_path && !(dimacs_path && has_suffix (dimacs_path, ".aag")))
+    APPERR ("option '-s' requires an AAG input file");
+  if (enumerate_path && (server || proof_specified))
+    APPERR ("option '-s' does not support proofs and server mode");
+  if (enumerate_path && (checkpoint_path || lemma_cache_path || export_path))
+    APPERR ("option '-s' can not be combined with '-k', '-m' or '-x' "
+            "(blocking gates are not implied by the circuit)");
   if (dimacs_specified && dimacs_path && proof_specified && proof_path &&
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
     APPERR ("DIMACS input file '%s' also specified as DRAT proof file",
@@ -696,9 +901,18 @@ int App::main (int argc, char **argv) {
   bool incremental;
   vector<int> cube_literals;
 
-    if (solver->internal->opts.satsolvermode == 1) { // (taomengxia): for circuit sat
+    if (aag_cnf_path && !(dimacs_path && has_suffix (dimacs_path, ".aag")))
+      APPERR ("option '-a %s' requires an AAG input file", aag_cnf_path);
+    if (server) {
+      set ("satsolvermode", 1);
+      set ("circuitoutputs", 0);
+    }
+    if (enumerate_path)
+      set ("satsolvermode", 1);
+    if (solver->internal->opts.satsolvermode == 1 ||
+        (dimacs_path && has_suffix (dimacs_path, ".aag"))) { // (taomengxia): for circuit sat
         incremental = false;
-        err = solver->circuit_read_aag(dimacs_path, max_var);
+        err = solver->circuit_read_aag(dimacs_path, max_var, aag_cnf_path);
     } else if (solver->internal->opts.satsolvermode == 2) { // (taomengxia): for easysat
         incremental = false;
         err = solver->internal->easysat_parse(argv[1]);
@@ -714,6 +928,48 @@ int App::main (int argc, char **argv) {
 
   if (err)
     APPERR ("%s", err);
+  if (server && solver->internal->circuit_graph &&
+      solver->internal->circuit_graph->is_sequential ())
+    APPERR ("option '--server' requires a combinational AIG");
+  if (enumerate_path && solver->internal->circuit_graph &&
+      solver->internal->circuit_graph->is_sequential ())
+    APPERR ("option '-s' requires a combinational AIG");
+  if (enumerate_path && !solver->internal->circuit_graph) {
+    solver->message ("ignoring enumeration file '%s' "
+                     "(only supported by the circuit engine)",
+                     enumerate_path);
+    enumerate_path = 0;
+  }
+  if (checkpoint_path) {
+    if (solver->internal->opts.satsolvermode != 1)
+      solver->message ("ignoring checkpoint file '%s' "
+                       "(only supported by the circuit engine)",
+                       checkpoint_path);
+    else {
+      if (File::exists (checkpoint_path)) {
+        solver->message ("resuming from checkpoint file '%s'",
+                         checkpoint_path);
+        solver->circuit_resume (checkpoint_path);
+      }
+      solver->circuit_checkpoint (checkpoint_path);
+    }
+  }
+  if (lemma_cache_path) {
+    if (solver->internal->opts.satsolvermode != 1)
+      solver->message ("ignoring lemma cache '%s' "
+                       "(only supported by the circuit engine)",
+                       lemma_cache_path);
+    else
+      solver->circuit_lemma_cache (lemma_cache_path);
+  }
+  if (hints_path) {
+    if (solver->internal->opts.satsolvermode != 1)
+      solver->message ("ignoring hint file '%s' "
+                       "(only supported by the circuit engine)",
+                       hints_path);
+    else if ((err = solver->circuit_read_hints (hints_path)))
+      APPERR ("%s", err);
+  }
   if (read_solution_path) {
     solver->section ("parsing solution");
     solver->message ("reading solution file from '%s'", read_solution_path);
@@ -730,7 +986,22 @@ int App::main (int argc, char **argv) {
 
   int res = 0;
 
-  if (incremental) {
+  if (server) {
+    solver->section ("serving queries");
+    res = serve (witness, conflict_limit, decision_limit);
+    status = false; // Results are printed per query.
+  } else if (enumerate_path) {
+    solver->section ("enumerating cubes");
+    FILE *file = fopen (enumerate_path, "w");
+    if (!file)
+      APPERR ("could not write cubes to '%s'", enumerate_path);
+    solver->message ("writing satisfying input cubes to %s'%s'%s",
+                     tout.green_code (), enumerate_path,
+                     tout.normal_code ());
+    res = solver->circuit_enumerate (file);
+    fclose (file);
+    status = witness = false; // Cubes are the result.
+  } else if (incremental) {
     bool reporting = get ("report") > 1 || get ("verbose") > 0;
     if (!reporting)
       set ("report", 0);
@@ -872,6 +1143,23 @@ int App::main (int argc, char **argv) {
       APPERR ("%s", err);
   }
 
+  if (export_path) {
+    solver->section ("writing circuit");
+    if (solver->internal->opts.satsolvermode != 1 ||
+        !solver->internal->circuit_graph)
+      solver->message ("ignoring circuit export '%s' "
+                       "(only supported by the circuit engine)",
+                       export_path);
+    else {
+      solver->message ("writing simplified circuit to AIGER file %s'%s'%s",
+                       tout.green_code (), export_path,
+                       tout.normal_code ());
+      err = solver->circuit_write_aig (export_path);
+      if (err)
+        APPERR ("%s", err);
+    }
+  }
+
   if (extension_path) {
     solver->section ("writing extension");
     solver->message ("writing extension stack to %s'%s'%s",
@@ -896,7 +1184,7 @@ int App::main (int argc, char **argv) {
   if (res == 10) {
     if (status)
       fputs ("s SATISFIABLE\n", write_result_file);
-    if (witness)
+    if (witness && !solver->circuit_write_witness (write_result_file))
       print_witness (write_result_file);
   } else if (res == 20 && status)
     fputs ("s UNSATISFIABLE\n", write_result_file);
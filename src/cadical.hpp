@@ -894,7 +894,69 @@ public:
   const char *read_dimacs (const char *path, int &vars, int strict,
                            bool &incremental, std::vector<int> &cubes);
 
-  const char* circuit_read_aag(const char *path, int &vars);
+  // Read an AIG in ASCII AIGER format.  In mode 'satsolvermode=1' the
+  // circuit engine works on the gates directly, otherwise the CNF encoding
+  // selected by 'circuitcnf' is fed to the configured engine.  If
+  // 'cnf_path' is given that encoding is also written in DIMACS format.
+  //
+  const char* circuit_read_aag(const char *path, int &vars,
+                               const char *cnf_path = 0);
+
+  // Current bytes used by a component of the circuit engine, which is one
+  // of 'watches', 'direct', 'original', 'learned', 'occs', 'bins', 'arena',
+  // 'permanent' or 'total' (all but the arena spaces).  Returns -1 for an
+  // unknown component.
+  //
+  int64_t circuit_memory(const char *component) const;
+
+  // Write checkpoints of the circuit engine to 'path' at restarts every
+  // 'circuitckptint' conflicts, and restore a checkpoint written for the
+  // same AIG at the beginning of the next 'solve'.  Invalid checkpoints
+  // are ignored with a warning.  Both are ignored while tracing proofs.
+  //
+  void circuit_checkpoint(const char *path);
+  void circuit_resume(const char *path);
+
+  // Import lemmas from the persistent lemma cache in 'path' at the next
+  // 'solve' (as far as they are valid for the current circuit) and add the
+  // short lemmas learned during that 'solve' to the cache afterwards.
+  // Lemmas refer to structural hashes of the nodes, thus they carry over
+  // to other revisions of the circuit.  Not imported while tracing proofs.
+  //
+  void circuit_lemma_cache(const char *path);
+
+  // Seed the decision heuristics of the circuit engine with per-node
+  // activity scores, phases and decision priorities read from 'path' (one
+  // '<node> <score> <phase> [<priority>]' line per AIG node).  Nodes are
+  // those of the AIG as read, even if rewriting replaced them.  Needs to be
+  // called after reading the AIG and returns an error message on failure.
+  //
+  const char *circuit_read_hints(const char *path);
+
+  // Sequential AIGs (with latches or bad state properties) are checked by
+  // bounded model checking up to 'circuitbmc' transitions in 'solve', which
+  // returns 10 if a bad state is reachable within this bound and 20 if not.
+  // The counterexample of the last satisfiable 'solve' is written in AIGER
+  // witness format, otherwise 'false' is returned and nothing is written.
+  //
+  bool circuit_write_witness(FILE *file) const;
+
+  // Write the circuit simplified by rewriting and the root-level units
+  // found so far in AIGER format to 'path' (binary if it ends in '.aig'),
+  // where fixed nodes with non-constant functions are asserted as extra
+  // outputs.  The comment section maps original nodes to the literals
+  // representing them.  Returns an error message on failure.
+  //
+  const char *circuit_write_aig(const char *path);
+
+  // Enumerate the input patterns satisfying a combinational AIG as cubes
+  // over its inputs written to 'file', one line per cube with '0', '1' and
+  // 'x' for don't-cares.  Each cube is blocked by an irredundant gate and
+  // the search continues incrementally.  Returns 20 if all satisfying
+  // patterns are covered, 10 if 'circuitenum' cubes were written and 0 if
+  // a limit was hit.  The blocking gates are kept afterwards.
+  //
+  int circuit_enumerate(FILE *file);
 
   //------------------------------------------------------------------------
   // Write current irredundant clauses and all derived unit clauses
@@ -1006,6 +1068,7 @@ private:
   friend class Parser;
   
   friend class Circuit_Parser;
+  friend struct Internal;   // circuit cube workers
 
   // Read solution in competition format for debugging and testing.
   //
@@ -26,7 +26,7 @@ Internal::Internal ()
 #ifndef QUIET
       profiles (this), force_phase_messages (false),
 #endif
-      arena (this), prefix ("c "), internal (this), external (0),
+      arena (this), circuit_permanent (this), prefix ("c "), internal (this), external (0),
       termination_forced (false), vars (this->max_var),
       lits (this->max_var) {
   control.push_back (Level (0, 0));
@@ -68,7 +68,8 @@ Internal::~Internal () {
 
     if (opts.satsolvermode == 1) {  // (taomengxia): for circuit sat
         for (const auto &g : circuit_gates)
-            circuit_delete_gate(g);
+            circuit_deallocate_gate(g);
+        delete circuit_graph;
     } else if (opts.satsolvermode == 2) { // (taomengxia): for easysat
         delete easysat_solver;
     }
@@ -106,6 +106,9 @@ extern "C" {
 #include <queue>
 #include "../src_circuit/circuit_gate.hpp"
 #include "../src_circuit/circuit_aig.hpp"
+#include "../src_circuit/circuit_features.hpp"
+#include "../src_circuit/circuit_lemma.hpp"
+#include "../src_circuit/circuit_memory.hpp"
 #include "../src_circuit/circuit_parser.hpp"
 #include "../src_circuit/circuit_watch.hpp"
 #include "../src_circuit/circuit_occs.hpp"
@@ -287,6 +290,7 @@ struct Internal {
   bool force_phase_messages; // force 'phase (...)' messages
 #endif
   Arena arena;          // memory arena for moving garbage collector
+  Arena circuit_permanent; // never moved original circuit gates
   Format error_message; // provide persistent error message
   string prefix;        // verbose messages prefix
 
@@ -1465,6 +1469,9 @@ struct Internal {
 public:
     vector<Circuit_Watches> circuit_wtab;                 // watch table
     vector<vector<int>> circuit_dwtab;                    // direct watch table
+    vector<Circuit_Suspended_Watches> circuit_suspended;  // lazy watches by blocking level
+    vector<Circuit_Saved_Literal> circuit_saved_trail;    // unassigned by last backjump
+    size_t circuit_saved_pos = 0;                         // next literal to replay
 
 
     Circuit_Gate* circuit_conflict_gate = nullptr;
@@ -1474,8 +1481,44 @@ public:
     int circuit_probe_reason_direct = 0;
 
     std::vector<Circuit_Gate*> circuit_gates;
+    bool circuit_permanent_built = false;                         // originals copied to 'circuit_permanent'
+    bool circuit_permanent_dirty = false;                         // permanent gate changed since last collection
+    int64_t circuit_original_bytes = 0;                           // bytes of irredundant gates
+    int64_t circuit_learned_bytes = 0;                            // bytes of redundant gates
+
+    Circuit_Graph *circuit_graph = nullptr;                       // parsed AIG (read-only after 'circuit_init')
+    std::vector<int> circuit_rewrite_map;                         // original node to graph literal (if rewritten)
+    std::string circuit_checkpoint_path;                          // written at restarts if non-empty
+    std::string circuit_resume_path;                              // restored by next 'circuit_solve'
+    std::string circuit_lemma_path;                               // persistent lemma cache if non-empty
+    Circuit_Lemmas circuit_lemmas;                                // cache contents (after loading)
+    bool circuit_lemmas_loaded = false;
+    unordered_map<uint64_t, uint64_t> circuit_direct_ids;        // LRAT ids of direct implications
+
+    std::vector<int> circuit_bmc_order;                   // topological order of the AIG gates
+    std::vector<int> circuit_bmc_map;                     // node literals in the last unrolled frame
+    std::vector<std::vector<int>> circuit_frame_inputs;   // input literals of each unrolled frame
+    std::vector<int> circuit_frame_bad;                   // bad state literal of each unrolled frame
+    int circuit_bmc_false = 0;                            // root-level false variable (for constants)
+    std::vector<std::string> circuit_bmc_witness;         // counterexample in AIGER witness format
+
+    bool circuit_structure_analyzed = false;
+    std::vector<int> circuit_reconvergent_gates;  // graph gates with reconvergent inputs
+    std::vector<int> circuit_structural_nodes;    // structural probes sorted by fanout
+    std::vector<int> circuit_defining_gates;      // graph gate defining each node
+    std::vector<int> circuit_original_units;      // outputs (and cubes) as justification roots
+    std::vector<int64_t> circuit_justify_stamps;  // nodes justified in the current check
+    std::vector<int> circuit_justify_stack;
+    int64_t circuit_justify_stamp = 0;
+    bool circuit_blocking = false;                // enumeration added blocking gates
+    bool circuit_justify_failed = false;          // completing a justified assignment failed
+    bool circuit_lucky_tried = false;             // lucky phases are only tried once
+    bool circuit_phases_seeded = false;           // saved phases set by hints, features or checkpoint
+    size_t circuit_reclearn_next = 0;             // next reconvergent gate to learn from
+    int64_t circuit_reclearn_budget = 0;
 
     vector<Circuit_Occs> circuit_otab;            // table of occurrences for all literals
+    vector<vector<uint64_t>> circuit_osigs;       // gate signatures parallel to 'circuit_otab'
     vector<Circuit_Bins> circuit_big;             // binary implication graph
 
     bool circuit_occurring () const { return !circuit_otab.empty (); }
@@ -1504,6 +1547,17 @@ public:
         ws.push_back(Circuit_Watch(blit, g));
     }
 
+    // Suspend the watch 'w' of 'lit' until backtracking below the level of
+    // its (false) blocking literal.
+    //
+    inline void circuit_suspend_watch(int blit_level, int lit, const Circuit_Watch &w) {
+        assert(blit_level > 0);
+        if ((size_t) blit_level >= circuit_suspended.size())
+            circuit_suspended.resize(blit_level + 1);
+        circuit_suspended[blit_level].push_back({lit, w});
+        stats.circuitsuspended++;
+    }
+
     inline void circuit_watch_gate(Circuit_Gate *g) {    // internal.hpp watch_clause()
         const int l0 = g->literals[0];
         const int l1 = g->literals[1];
@@ -1515,8 +1569,8 @@ public:
         // 构造一跳向左直接蕴含图
         // AND节点向左蕴含规则：输出为非监视值，可以蕴含出两个输入都为监视值
         auto input1 = g->literals[0];
-        auto input2 = g->literals[1];
-        auto output = g->literals[2];
+        auto input2 = g->literals[g->size - 2];     // same for equivalences
+        auto output = g->literals[g->size - 1];
 
         auto& left_dimp = circuit_direct_watches(-output);
         left_dimp.push_back(input1);
@@ -1539,9 +1593,59 @@ public:
     }
 
     /// API: implement in circuit_internal.cpp
+    Circuit_Gate *circuit_add_original_gate(int output, const std::vector<int> &inputs);
     void circuit_init(const Circuit_Graph *grap_ptr);
     int circuit_solve();
     int circuit_cdcl_loop_with_inprocessing();
+    int circuit_try_to_satisfy_formula_by_saved_phases();
+
+    /// bounded model checking API: implement in circuit_bmc.cpp
+    bool circuit_unroll();
+    void circuit_bmc_extract_witness();
+    int circuit_bmc();
+
+    /// cube-and-conquer API: implement in circuit_cube.cpp
+    std::vector<int> circuit_cube_candidates();
+    int circuit_lookahead_split(const std::vector<int> &candidates);
+    CubesWithStatus circuit_generate_cubes(int depth);
+    int circuit_solve_cubes(const std::vector<std::vector<int>> &cubes);
+    int circuit_cube_and_conquer();
+
+    /// checkpoint API: implement in circuit_checkpoint.cpp
+    uint64_t circuit_fingerprint() const;
+    void circuit_checkpoint_file(const char *path);
+    void circuit_resume_file(const char *path);
+    bool circuit_checkpointing();
+    bool circuit_checkpoint();
+    bool circuit_restore_checkpoint();
+
+    /// enumeration API: implement in circuit_enumerate.cpp
+    void circuit_block_cube(const std::vector<int> &cube);
+    int circuit_enumerate(FILE *file);
+
+    /// hints API: implement in circuit_hints.cpp
+    const char *circuit_read_hints(const char *path);
+
+    /// lemma cache API: implement in circuit_lemma.cpp
+    void circuit_lemma_file(const char *path);
+    std::vector<uint64_t> circuit_lemma_context(const std::vector<uint64_t> &hashes) const;
+    void circuit_load_lemmas();
+    void circuit_save_lemmas();
+
+    /// lucky API: implement in circuit_lucky.cpp
+    int circuit_lucky_phases();
+
+    /// memory API: implement in circuit_memory.cpp
+    void circuit_account_gate(const Circuit_Gate *g, int64_t delta);
+    Circuit_Memory circuit_memory() const;
+    int64_t circuit_memory(const char *name) const;
+    void circuit_print_memory();
+
+    /// features API: implement in circuit_features.cpp
+    Circuit_Features circuit_compute_features(const Circuit_Graph &graph);
+    void circuit_apply_preset(const char *name);
+    int circuit_select_engine(const Circuit_Features &features);
+    void circuit_seed_phases(const std::vector<signed char> &witness);
 
     /// analyze API: implement in circuit_analyze.cpp
     void circuit_learn_empty_clause();
@@ -1569,6 +1673,9 @@ public:
 
     /// decide API: implement in circuit_decide.cpp
     bool circuit_satisfied();
+    bool circuit_justifying();
+    bool circuit_justified(std::vector<int> *cube = nullptr);
+    int circuit_satisfy_justified();
     int circuit_decide_phase(int idx, bool target);
     int circuit_likely_phase(int idx);
     int circuit_decide();
@@ -1580,10 +1687,20 @@ public:
     void circuit_deallocate_gate(Circuit_Gate *g);
     void circuit_delete_gate(Circuit_Gate *g);
     void circuit_mark_garbage(Circuit_Gate *g);
-    void circuit_assign_original_unit(int lit);
+    void circuit_assign_original_unit(uint64_t id, int lit);
     Circuit_Gate *circuit_new_learned_redundant_gate(int glue);
     Circuit_Gate *circuit_new_hyper_binary_resolved_clause(bool red, int glue);
 
+    /// proof API: implement in circuit_proof.cpp
+    void circuit_proof_add_original_gate(Circuit_Gate *g);
+    void circuit_proof_add_derived_gate(Circuit_Gate *g);
+    void circuit_proof_delete_gate(Circuit_Gate *g);
+    void circuit_proof_flush_gate(Circuit_Gate *g);
+    void circuit_proof_strengthen_gate(Circuit_Gate *g, int lit);
+    uint64_t circuit_direct_id(int lit, int direct);
+    void circuit_build_chain_for_units(int lit, Circuit_Gate *reason, int reason_direct);
+    void circuit_build_chain_for_conflict(Circuit_Gate *conflict, const std::array<int, 2> &conflict_direct);
+
     /// propagate API: implement in circuit_propagate.cpp
     int circuit_assignment_level(int lit, Circuit_Gate *reason);
     void circuit_search_assign(int lit, Circuit_Gate *reason, int reason_direct);
@@ -1611,6 +1728,8 @@ public:
     void circuit_update_reason_references();
     void circuit_delete_garbage_gates();
     void circuit_copy_gate(Circuit_Gate *g);
+    void circuit_copy_permanent_gates();
+    bool circuit_permanent_gate(Circuit_Gate *g) const { return circuit_permanent.contains(g); }
     void circuit_copy_non_garbage_gates();
     bool circuit_arenaing();
     void circuit_garbage_collection();
@@ -1688,6 +1807,15 @@ public:
     bool circuit_probe_round ();
     void circuit_probe (bool update_limits = true);
 
+    /// parallel probe API: implement in circuit_probe_parallel.cpp
+    unsigned circuit_probe_threads ();
+    void circuit_probe_parallel (int64_t limit);
+
+    /// structure API: implement in circuit_structure.cpp
+    void circuit_analyze_structure();
+    bool circuit_justify(const Circuit_LogicGate *gate, int depth, std::vector<int> &res);
+    void circuit_recursive_learning();
+
     /// subsume API: implement in circuit_subsume.cpp
     bool circuit_subsuming ();
     void circuit_strengthen_clause(Circuit_Gate *c, int lit);
@@ -1707,6 +1835,18 @@ public:
     void circuit_sort_watches ();
     void circuit_clear_watches ();
     void circuit_reset_watches ();
+    void circuit_restore_watches (int new_level = 0);
+
+    /// rewriting API: implement in circuit_rewrite.cpp
+    Circuit_Graph *circuit_rewrite (const Circuit_Graph &graph);
+
+    /// export API: implement in circuit_export.cpp
+    const char *circuit_write_aig(const char *path);
+
+    /// trail saving API: implement in circuit_trail.cpp
+    void circuit_save_trail (int new_level, int max_level);
+    void circuit_replay_trail ();
+    void circuit_clear_saved_trail ();
 
     /// decompose API: implement in circuit_decompose.cpp
     void circuit_decompose ();
@@ -12,6 +12,7 @@ struct Limit {
   int64_t preprocessing; // limit on preprocessing rounds
   int64_t localsearch;   // limit on local search rounds
 
+  int64_t checkpoint; // conflict limit for next circuit checkpoint
   int64_t compact;   // conflict limit for next 'compact'
   int64_t condition; // conflict limit for next 'condition'
   int64_t elim;      // conflict limit for next 'elim'
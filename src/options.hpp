@@ -44,6 +44,30 @@ OPTION( chrono,            1,  0,  2,0,0,1, "chronological backtracking") \
 OPTION( chronoalways,      0,  0,  1,0,0,1, "force always chronological") \
 OPTION( chronolevelim,   1e2,  0,2e9,0,0,1, "chronological level limit") \
 OPTION( chronoreusetrail,  1,  0,  1,0,0,1, "reuse trail chronologically") \
+OPTION( circuitbmc,      1e3,  0,2e9,0,0,1, "maximum bound for sequential AIGs") \
+OPTION( circuitckptint,  1e4,  1,2e9,0,0,1, "conflicts between circuit checkpoints") \
+OPTION( circuitcnf,        2,  1,  2,0,0,1, "AAG to CNF: 1=Tseitin, 2=Plaisted-Greenbaum") \
+OPTION( circuitcube,       0,  0, 20,0,0,1, "circuit cube depth (0=disabled)") \
+OPTION( circuitcubefanout, 8,  1,2e9,0,0,1, "minimum fanout of internal split nodes") \
+OPTION( circuitcubeprobes,64,  1,2e9,0,0,1, "lookahead candidates per split") \
+OPTION( circuitcubethreads,0,  0,256,0,0,1, "cube solving threads (0=all cores)") \
+OPTION( circuitenum,       0,  0,2e9,0,0,1, "maximum enumerated cubes (0=all)") \
+OPTION( circuitjustify,    1,  0,  1,0,0,1, "stop search once outputs are justified") \
+OPTION( circuitlazy,       1,  0,  1,0,0,1, "suspend watches of satisfied gates") \
+OPTION( circuitlemmamax, 1e5,  0,2e9,0,0,1, "maximum lemmas in the lemma cache") \
+OPTION( circuitlemmasize,  8,  2,1e3,0,0,1, "maximum size of cached learned gates") \
+OPTION( circuitlucky,     64,  0,1e5,0,0,1, "lucky simulation rounds of 64 patterns") \
+OPTION( circuitoutputs,    1,  0,  1,0,0,1, "assert outputs (0=only assumptions)") \
+OPTION( circuitprobefanout,8,  2,2e9,0,0,1, "minimum fanout of structural probes") \
+OPTION( circuitprobestruct,1,  0,  1,0,0,1, "probe reconvergence and high-fanout nodes") \
+OPTION( circuitprobethreads,1,0,256,0,0,1, "parallel probing threads (0=all cores)") \
+OPTION( circuitreclearn,   1,  0,  3,0,0,1, "recursive learning depth (0=disabled)") \
+OPTION( circuitreclearnlim,1e4,0,2e9,0,0,1, "recursive learning decisions per probing") \
+OPTION( circuitreconvdepth,3,  1,  8,0,0,1, "depth bound of reconvergence detection") \
+OPTION( circuitrewrite,    1,  0, 10,0,0,1, "AIG rewriting rounds (0=disabled)") \
+OPTION( circuitrewritelim,1e6, 0,2e9,0,0,1, "maximum cuts evaluated by rewriting") \
+OPTION( circuitsimrounds, 16,  0,1e4,0,0,1, "random 64-bit simulation rounds for engine selection") \
+OPTION( circuittrailsave,  1,  0,  1,0,0,1, "replay saved trail after backjumps") \
 OPTION( compact,           1,  0,  1,0,1,1, "compact internal variables") \
 OPTION( compactint,      2e3,  1,2e9,0,0,1, "compacting interval") \
 OPTION( compactlim,      1e2,  0,1e3,0,0,1, "inactive limit per mille") \
@@ -145,7 +169,7 @@ OPTION( restartreusetrail, 1,  0,  1,0,0,1, "enable trail reuse") \
 OPTION( restoreall,        0,  0,  2,0,0,1, "restore all clauses (2=really)") \
 OPTION( restoreflush,      0,  0,  1,0,0,1, "remove satisfied clauses") \
 OPTION( reverse,           0,  0,  1,0,0,1, "reverse variable ordering") \
-OPTION( satsolvermode,     1,  0,  3,0,0,1, "1=circuitsat, 2=easysat, 3=cadical") \
+OPTION( satsolvermode,     0,  0,  3,0,0,1, "0=auto, 1=circuitsat, 2=easysat, 3=cadical") \
 OPTION( score,             1,  0,  1,0,0,1, "use EVSIDS scores") \
 OPTION( scorefactor,     950,500,1e3,0,0,1, "score factor per mille") \
 OPTION( seed,              0,  0,2e9,0,0,1, "random seed") \
@@ -164,6 +188,7 @@ OPTION( stats,             0,  0,  1,0,0,1, "print all statistics at the end of
 OPTION( subsume,           1,  0,  1,0,1,1, "enable clause subsumption") \
 OPTION( subsumebinlim,   1e4,  0,2e9,1,0,1, "watch list length limit") \
 OPTION( subsumeclslim,   1e2,  0,2e9,2,0,1, "clause length limit") \
+OPTION( subsumeinc,        1,  0,  1,0,0,1, "only subsume gates added or shrunk since checked") \
 OPTION( subsumeint,      1e4,  1,2e9,0,0,1, "subsume interval") \
 OPTION( subsumelimited,    1,  0,  1,0,0,1, "limit subsumption checks") \
 OPTION( subsumemaxeff,   1e8,  0,2e9,1,0,1, "maximum subsuming efficiency") \
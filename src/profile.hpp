@@ -43,6 +43,7 @@ struct Internal;
   PROFILE (block, 2) \
   PROFILE (bump, 4) \
   PROFILE (checking, 2) \
+  PROFILE (checkpoint, 3) \
   PROFILE (cdcl, 1) \
   PROFILE (collect, 3) \
   PROFILE (compact, 3) \
@@ -56,6 +57,7 @@ struct Internal;
   PROFILE (extend, 3) \
   PROFILE (instantiate, 2) \
   PROFILE (lucky, 2) \
+  PROFILE (lemmas, 3) \
   PROFILE (lookahead, 2) \
   PROFILE (minimize, 4) \
   PROFILE (shrink, 4) \
@@ -64,9 +66,11 @@ struct Internal;
   PROFILE (probe, 2) \
   PROFILE (deduplicate, 3) \
   PROFILE (propagate, 4) \
+  PROFILE (reclearn, 3) \
   PROFILE (reduce, 3) \
   PROFILE (restart, 3) \
   PROFILE (restore, 2) \
+  PROFILE (rewrite, 2) \
   PROFILE (search, 1) \
   PROFILE (solve, 0) \
   PROFILE (stable, 2) \
@@ -75,6 +79,7 @@ struct Internal;
   PROFILE (subsume, 2) \
   PROFILE (ternary, 2) \
   PROFILE (transred, 3) \
+  PROFILE (unroll, 3) \
   PROFILE (unstable, 2) \
   PROFILE (vivify, 2) \
   PROFILE (walk, 2)
@@ -109,11 +109,15 @@ Report::Report (const char *h, int precision, int min, double value)
 // more interesting report is due to learning a unit, called iteration, with
 // prefix 'i'.  To add another statistics column, add a corresponding line
 // here.  If you want to report something else add 'report (..)' functions.
+// Columns added with 'CIRCUIT_REPORT' are only shown for the circuit engine.
 
 #define TIME opts.reportsolve ? solve_time () : time ()
 
 #define MB (current_resident_set_size () / (double) (1l << 20))
 
+#define CIRCUITMB \
+  ((circuit_original_bytes + circuit_learned_bytes) / (double) (1l << 20))
+
 #define REMAINING (percent (active (), external->max_var))
 
 #define TRAIL (percent (averages.current.trail.slow, max_var))
@@ -126,6 +130,7 @@ Report::Report (const char *h, int precision, int min, double value)
   /*     HEADER, PRECISION, MIN, VALUE */ \
   REPORT ("seconds", 2, 5, TIME) \
   REPORT ("MB", 0, 2, MB) \
+  CIRCUIT_REPORT ("gateMB", 0, 2, CIRCUITMB) \
   REPORT ("level", 0, 2, averages.current.level) \
   REPORT ("reductions", 0, 1, stats.reductions) \
   REPORT ("restarts", 0, 3, stats.restarts) \
@@ -149,7 +154,9 @@ REPORT("maxvar",       0, 2, external->max_var)
 
 static const int num_reports = // as compile time constant
 #define REPORT(HEAD, PREC, MIN, EXPR) 1 +
+#define CIRCUIT_REPORT REPORT
     REPORTS
+#undef CIRCUIT_REPORT
 #undef REPORT
     0;
 
@@ -176,7 +183,12 @@ void Internal::report (char type, int verbose) {
 #define REPORT(HEAD, PREC, MIN, EXPR) \
   assert (n < num_reports); \
   reports[n++] = Report (HEAD, PREC, MIN, (double) (EXPR));
+#define CIRCUIT_REPORT(HEAD, PREC, MIN, EXPR) \
+  if (opts.satsolvermode == 1) { \
+    REPORT (HEAD, PREC, MIN, EXPR) \
+  }
   REPORTS
+#undef CIRCUIT_REPORT
 #undef REPORT
   if (!lim.report) {
     print_prefix ();
@@ -1368,18 +1368,103 @@ const char *Solver::read_dimacs (const char *path, int &vars, int strict,
   return err;
 }
 
-const char *Solver::circuit_read_aag(const char *path, int &vars) {
+const char *Solver::circuit_read_aag(const char *path, int &vars,
+                                     const char *cnf_path) {
   if (!path) {
     return internal->error_message.init ("failed to read aag file, aag file is empty.");
   }
   LOG_API_CALL_BEGIN ("read_aag", path);
   Circuit_Parser *parser = new Circuit_Parser(this);
-  const char *err = parser->parse_aag(path, vars);
+  const char *err = parser->parse_aag(path, vars, cnf_path);
   delete parser;
   LOG_API_CALL_RETURNS ("read aag", path, err);
   return err;
 }
 
+int64_t Solver::circuit_memory (const char *component) const {
+  TRACE ("circuit_memory");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (component, "zero component name");
+  int64_t res = internal->circuit_memory (component);
+  LOG_API_CALL_RETURNS ("circuit_memory", res);
+  return res;
+}
+
+void Solver::circuit_checkpoint (const char *path) {
+  LOG_API_CALL_BEGIN ("circuit_checkpoint", path);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (path, "zero checkpoint path");
+  internal->circuit_checkpoint_file (path);
+  LOG_API_CALL_END ("circuit_checkpoint", path);
+}
+
+void Solver::circuit_resume (const char *path) {
+  LOG_API_CALL_BEGIN ("circuit_resume", path);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (path, "zero checkpoint path");
+  internal->circuit_resume_file (path);
+  LOG_API_CALL_END ("circuit_resume", path);
+}
+
+void Solver::circuit_lemma_cache (const char *path) {
+  LOG_API_CALL_BEGIN ("circuit_lemma_cache", path);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (path, "zero lemma cache path");
+  internal->circuit_lemma_file (path);
+  LOG_API_CALL_END ("circuit_lemma_cache", path);
+}
+
+const char *Solver::circuit_read_hints (const char *path) {
+  LOG_API_CALL_BEGIN ("circuit_read_hints", path);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (path, "zero hint file path");
+  const char *err = internal->circuit_read_hints (path);
+  LOG_API_CALL_RETURNS ("circuit_read_hints", path, err);
+  return err;
+}
+
+bool Solver::circuit_write_witness (FILE *file) const {
+  TRACE ("circuit_write_witness");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (file, "zero witness file");
+  if (state () != SATISFIED || internal->circuit_bmc_witness.empty ())
+    return false;
+  for (const auto &line : internal->circuit_bmc_witness)
+    fprintf (file, "%s\n", line.c_str ());
+  return true;
+}
+
+const char *Solver::circuit_write_aig (const char *path) {
+  LOG_API_CALL_BEGIN ("circuit_write_aig", path);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (path, "zero export file path");
+  const char *err = internal->circuit_write_aig (path);
+  LOG_API_CALL_RETURNS ("circuit_write_aig", path, err);
+  return err;
+}
+
+int Solver::circuit_enumerate (FILE *file) {
+  TRACE ("circuit_enumerate");
+  REQUIRE_READY_STATE ();
+  REQUIRE (file, "zero enumeration file");
+  REQUIRE (internal->opts.satsolvermode == 1 && internal->circuit_graph &&
+               !internal->circuit_graph->is_sequential (),
+           "can only enumerate combinational circuits");
+  REQUIRE (!internal->proof, "can not enumerate while tracing proofs");
+  transition_to_steady_state ();
+  REQUIRE (external->assumptions.empty (),
+           "can not enumerate under assumptions");
+  STATE (SOLVING);
+  const int res = internal->circuit_enumerate (file);
+  if (res == 20)
+    STATE (UNSATISFIED);
+  else
+    STATE (STEADY);
+  external->reset_limits ();
+  LOG_API_CALL_RETURNS ("circuit_enumerate", res);
+  return res;
+}
+
 const char *Solver::read_solution (const char *path) {
   LOG_API_CALL_BEGIN ("solution", path);
   REQUIRE_VALID_STATE ();
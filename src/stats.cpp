@@ -73,6 +73,14 @@ void Stats::print (Internal *internal) {
     PRT ("  pureclauses:   %15" PRId64 "   %10.2f    per pure literal",
          stats.blockpured, relative (stats.blockpured, stats.all.pure));
   }
+  if (all || stats.circuitbmc.frames) {
+    PRT ("bmc:             %15" PRId64 "   %10.2f    conflicts per frame",
+         stats.circuitbmc.frames,
+         relative (stats.conflicts, stats.circuitbmc.frames));
+    PRT ("  gates:         %15" PRId64 "   %10.2f    per frame",
+         stats.circuitbmc.gates,
+         relative (stats.circuitbmc.gates, stats.circuitbmc.frames));
+  }
   if (all || stats.chrono)
     PRT ("chronological:   %15" PRId64 "   %10.2f %%  of conflicts",
          stats.chrono, percent (stats.chrono, stats.conflicts));
@@ -136,6 +144,11 @@ void Stats::print (Internal *internal) {
     PRT ("  searched:      %15" PRId64 "   %10.2f    per decision",
          stats.searched, relative (stats.searched, stats.decisions));
   }
+  if (all || stats.circuitenum.cubes) {
+    PRT ("enumerated:      %15" PRId64 "   %10.2f    literals per cube",
+         stats.circuitenum.cubes,
+         relative (stats.circuitenum.literals, stats.circuitenum.cubes));
+  }
   if (all || stats.all.eliminated) {
     PRT ("eliminated:      %15" PRId64 "   %10.2f %%  of all variables",
          stats.all.eliminated, percent (stats.all.eliminated, stats.vars));
@@ -219,6 +232,11 @@ void Stats::print (Internal *internal) {
          stats.hbreds, percent (stats.hbreds, stats.hbrs));
     PRT ("  hbrsubs:       %15" PRId64 "   %10.2f %%  per hbr",
          stats.hbrsubs, percent (stats.hbrsubs, stats.hbrs));
+    PRT ("  reclearned:    %15" PRId64 "   %10.2f    per probed",
+         stats.reclearned, relative (stats.reclearned, stats.probed));
+    PRT ("  reclearnunits: %15" PRId64 "   %10.2f    per phase",
+         stats.reclearnunits,
+         relative (stats.reclearnunits, stats.probingphases));
   }
   PRT ("  units:         %15" PRId64 "   %10.2f    interval", stats.units,
        relative (stats.conflicts, stats.units));
@@ -239,6 +257,14 @@ void Stats::print (Internal *internal) {
     PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds",
          stats.instrounds, percent (stats.instrounds, stats.elimrounds));
   }
+  if (all || stats.circuitjustify.satisfied) {
+    PRT ("justified:       %15" PRId64 "   %10.2f %%  of checks",
+         stats.circuitjustify.satisfied,
+         percent (stats.circuitjustify.satisfied, stats.circuitjustify.checks));
+    PRT ("  checks:        %15" PRId64 "   %10.2f    per decision",
+         stats.circuitjustify.checks,
+         relative (stats.circuitjustify.checks, stats.decisions));
+  }
   if (all || stats.conflicts) {
     PRT ("learned:         %15" PRId64 "   %10.2f %%  per conflict",
          stats.learned.clauses,
@@ -260,6 +286,12 @@ void Stats::print (Internal *internal) {
     PRT ("lucky:           %15" PRId64 "   %10.2f %%  of tried",
          stats.lucky.succeeded,
          percent (stats.lucky.succeeded, stats.lucky.tried));
+    PRT ("  simulation     %15" PRId64 "   %10.2f %%  of tried",
+         stats.lucky.simulation,
+         percent (stats.lucky.simulation, stats.lucky.tried));
+    PRT ("  simulated      %15" PRId64 "   %10.2f    per tried",
+         stats.lucky.simulated,
+         relative (stats.lucky.simulated, stats.lucky.tried));
     PRT ("  constantzero   %15" PRId64 "   %10.2f %%  of tried",
          stats.lucky.constant.zero,
          percent (stats.lucky.constant.zero, stats.lucky.tried));
@@ -323,6 +355,14 @@ void Stats::print (Internal *internal) {
   PRT ("  searchprops:   %15" PRId64 "   %10.2f %%  of propagations",
        stats.propagations.search,
        percent (stats.propagations.search, propagations));
+  if (all || stats.circuitsuspended)
+    PRT ("  suspended:     %15" PRId64 "   %10.2f    per searchprop",
+         stats.circuitsuspended,
+         relative (stats.circuitsuspended, stats.propagations.search));
+  if (all || stats.circuittrail.replayed)
+    PRT ("  replayed:      %15" PRId64 "   %10.2f %%  of saved",
+         stats.circuittrail.replayed,
+         percent (stats.circuittrail.replayed, stats.circuittrail.saved));
   PRT ("  transredprops: %15" PRId64 "   %10.2f %%  of propagations",
        stats.propagations.transred,
        percent (stats.propagations.transred, propagations));
@@ -332,6 +372,30 @@ void Stats::print (Internal *internal) {
   PRT ("  walkprops:     %15" PRId64 "   %10.2f %%  of propagations",
        stats.propagations.walk,
        percent (stats.propagations.walk, propagations));
+#ifdef CIRCUITSTATS
+  for (int mode = 0; mode < 2 && internal->opts.satsolvermode == 1; mode++) {
+    const auto &p = stats.circuitprop[mode];
+    PRT ("%s %15" PRId64 "   %10.2f %%  of searchprops",
+         mode ? "circuitstable:  " : "circuitunstable:", p.props,
+         percent (p.props, stats.propagations.search));
+    PRT ("  directs:       %15" PRId64 "   %10.2f    per propagation",
+         p.directs, relative (p.directs, p.props));
+    PRT ("  watches:       %15" PRId64 "   %10.2f    per propagation",
+         p.watches, relative (p.watches, p.props));
+    PRT ("  blits:         %15" PRId64 "   %10.2f %%  of watches",
+         p.blits, percent (p.blits, p.watches));
+    PRT ("  others:        %15" PRId64 "   %10.2f %%  of watches",
+         p.others, percent (p.others, p.watches));
+    PRT ("  searches:      %15" PRId64 "   %10.2f %%  of watches",
+         p.searches, percent (p.searches, p.watches));
+    PRT ("  scans:         %15" PRId64 "   %10.2f    per search",
+         p.scans, relative (p.scans, p.searches));
+    PRT ("  gateconfs:     %15" PRId64 "   %10.2f %%  of conflicts",
+         p.gateconfs, percent (p.gateconfs, p.gateconfs + p.dirconfs));
+    PRT ("  dirconfs:      %15" PRId64 "   %10.2f %%  of conflicts",
+         p.dirconfs, percent (p.dirconfs, p.gateconfs + p.dirconfs));
+  }
+#endif
   if (all || stats.reactivated) {
     PRT ("reactivated:     %15" PRId64 "   %10.2f %%  of all variables",
          stats.reactivated, percent (stats.reactivated, stats.vars));
@@ -378,6 +442,18 @@ void Stats::print (Internal *internal) {
     PRT ("  reusedlevels:  %15" PRId64 "   %10.2f %%  per restart levels",
          stats.reusedlevels,
          percent (stats.reusedlevels, stats.restartlevels));
+    if (all || stats.circuitckpts)
+      PRT ("  checkpoints:   %15" PRId64 "   %10.2f    interval",
+           stats.circuitckpts,
+           relative (stats.conflicts, stats.circuitckpts));
+  }
+  if (all || stats.circuitlemmas.imported || stats.circuitlemmas.saved) {
+    PRT ("lemmacache:      %15" PRId64 "   %10.2f    imported per saved",
+         stats.circuitlemmas.imported,
+         relative (stats.circuitlemmas.imported, stats.circuitlemmas.saved));
+    PRT ("  saved:         %15" PRId64 "   %10.2f %%  of redundant",
+         stats.circuitlemmas.saved,
+         percent (stats.circuitlemmas.saved, stats.added.redundant));
   }
   if (all || stats.restored) {
     PRT ("restored:        %15" PRId64 "   %10.2f %%  per weakened",
@@ -388,6 +464,17 @@ void Stats::print (Internal *internal) {
     PRT ("  literals:      %15" PRId64 "   %10.2f    per restored clause",
          stats.restoredlits, relative (stats.restoredlits, stats.restored));
   }
+  if (all || stats.circuitrewrite.rounds) {
+    PRT ("rewritten:       %15" PRId64 "   %10.2f    per round",
+         stats.circuitrewrite.rewritten,
+         relative (stats.circuitrewrite.rewritten, stats.circuitrewrite.rounds));
+    PRT ("  removed:       %15" PRId64 "   %10.2f    per rewritten",
+         stats.circuitrewrite.removed,
+         relative (stats.circuitrewrite.removed, stats.circuitrewrite.rewritten));
+    PRT ("  added:         %15" PRId64 "   %10.2f %%  of removed",
+         stats.circuitrewrite.added,
+         percent (stats.circuitrewrite.added, stats.circuitrewrite.removed));
+  }
   if (all || stats.stabphases) {
     PRT ("stabilizing:     %15" PRId64 "   %10.2f %%  of conflicts",
          stats.stabphases, percent (stats.stabconflicts, stats.conflicts));
@@ -431,6 +518,8 @@ void Stats::print (Internal *internal) {
          stats.subchecks, relative (stats.subchecks, stats.subtried));
     PRT ("  subchecks2:    %15" PRId64 "   %10.2f %%  per subcheck",
          stats.subchecks2, percent (stats.subchecks2, stats.subchecks));
+    PRT ("  subsigs:       %15" PRId64 "   %10.2f %%  of candidates",
+         stats.subsigs, percent (stats.subsigs, stats.subsigs + stats.subchecks));
     PRT ("  elimotfsub:    %15" PRId64 "   %10.2f %%  of subsumed",
          stats.elimotfsub, percent (stats.elimotfsub, stats.subsumed));
     PRT ("  elimbwsub:     %15" PRId64 "   %10.2f %%  of subsumed",
@@ -558,6 +647,8 @@ void Internal::print_resource_usage () {
        internal->real_time ());
   MSG ("maximum resident set size of process:    %12.2f    MB",
        m / (double) (1l << 20));
+  if (opts.satsolvermode == 1)
+    circuit_print_memory ();
 #endif
 }
 
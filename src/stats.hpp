@@ -26,6 +26,21 @@ struct Stats {
     int64_t walk;        // propagated during local search
   } propagations;
 
+  // Hot path counters of 'circuit_propagate', indexed by 'stable' and
+  // only updated if compiled with '-DCIRCUITSTATS' ('--circuit-stats').
+  //
+  struct {
+    int64_t props;     // propagated literals
+    int64_t directs;   // visited direct implications
+    int64_t watches;   // visited watches
+    int64_t blits;     // watches skipped by blocking literal
+    int64_t others;    // watches skipped by other watched literal
+    int64_t searches;  // replacement searches
+    int64_t scans;     // skipped literals in replacement searches
+    int64_t gateconfs; // conflicts on gates
+    int64_t dirconfs;  // conflicts on direct implications
+  } circuitprop[2];
+
   struct {
     int64_t ext_cb;     // number of times any external callback was called
     int64_t eprop_call; // number of times external_propagate was called
@@ -83,6 +98,8 @@ struct Stats {
   struct {
     int64_t tried;
     int64_t succeeded;
+    int64_t simulated;  // circuit input patterns simulated
+    int64_t simulation; // circuits satisfied by simulation
     struct {
       int64_t one, zero;
     } constant, forward, backward;
@@ -116,6 +133,34 @@ struct Stats {
 
   int64_t compacts;       // number of compactifications
   int64_t shuffled;       // shuffled queues and scores
+  int64_t circuitckpts;   // written circuit checkpoints
+  int64_t circuitsuspended; // lazily suspended circuit watches
+  struct {
+    int64_t saved;    // literals saved on backjumps and restarts
+    int64_t replayed; // saved literals assigned again by replay
+  } circuittrail;
+  struct {
+    int64_t rounds;    // AIG rewriting rounds
+    int64_t rewritten; // nodes replaced by library subgraphs
+    int64_t removed;   // original nodes removed from the AIG
+    int64_t added;     // new nodes added to the AIG
+  } circuitrewrite;
+  struct {
+    int64_t imported; // lemmas imported from the lemma cache
+    int64_t saved;    // lemmas added to the lemma cache
+  } circuitlemmas;
+  struct {
+    int64_t frames;   // unrolled frames of sequential AIGs
+    int64_t gates;    // gates added by unrolling
+  } circuitbmc;
+  struct {
+    int64_t cubes;    // input cubes written by enumeration
+    int64_t literals; // literals of blocking gates
+  } circuitenum;
+  struct {
+    int64_t checks;    // justification checks before decisions
+    int64_t satisfied; // models completed from justified assignments
+  } circuitjustify;
   int64_t restarts;       // actual number of happened restarts
   int64_t restartlevels;  // levels at restart
   int64_t restartstable;  // actual number of happened restarts
@@ -142,6 +187,8 @@ struct Stats {
   int64_t hbrsizes;       // sum of hyper resolved base clauses
   int64_t hbreds;         // redundant hyper binary resolvents
   int64_t hbrsubs;        // subsuming hyper binary resolvents
+  int64_t reclearned;     // binary gates from recursive learning
+  int64_t reclearnunits;  // units from recursive learning
   int64_t instried;       // number of tried instantiations
   int64_t instantiated;   // number of successful instantiations
   int64_t instrounds;     // number of instantiation rounds
@@ -156,6 +203,7 @@ struct Stats {
   int64_t subtried;  // number of tried subsumptions
   int64_t subchecks; // number of pair-wise subsumption checks
   int64_t subchecks2;    // same but restricted to binary clauses
+  int64_t subsigs;       // subsumption checks filtered by signatures
   int64_t elimotfsub;    // number of on-the-fly subsumed during elimination
   int64_t subsumerounds; // number of subsumption rounds
   int64_t subsumephases; // number of scheduled subsumption phases
@@ -1,5 +1,8 @@
 #include "circuit_aig.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace CaDiCaL {
 
 void Circuit_Graph::add_input(const int input) {
@@ -26,4 +29,193 @@ void Circuit_Graph::add_and_gate(const int output, const std::vector<int> &input
     m_gates.emplace_back(gate);
 }
 
+void Circuit_Graph::add_latch(const int latch, const int next, const int reset) {
+    assert(latch % 2 == 0);
+    assert(reset == 0 || reset == 1 || reset == latch);
+    const signed char value = reset == latch ? 0 : reset ? 1 : -1;
+    m_latches.push_back({latch / 2, AIG_ID_CONVERT(next), value});
+}
+
+void Circuit_Graph::add_bad(const int bad) {
+    m_bad.push_back(AIG_ID_CONVERT(bad));
+}
+
+void Circuit_Graph::add_constraint(const int constraint) {
+    m_constraints.push_back(AIG_ID_CONVERT(constraint));
+}
+
+std::vector<int> Circuit_Graph::compute_fanouts() const {
+    std::vector<int> fanouts(m_max_var + 1, 0);
+    for (const auto gate : m_gates)
+        for (const auto input : gate->get_PIs())
+            fanouts[abs(input)]++;
+    for (const auto output : m_outputs)
+        fanouts[abs(output)]++;
+    return fanouts;
+}
+
+std::vector<int> Circuit_Graph::topological_order() const {
+    std::vector<int> defining(m_max_var + 1, -1);
+    for (size_t i = 0; i < m_gates.size(); i++)
+        defining[m_gates[i]->get_PO()] = i;
+
+    // Iterative post-order traversal, where 'state' is 1 while a gate is on
+    // the stack and 2 after it has been added to the order.
+    //
+    std::vector<int> order, stack;
+    std::vector<signed char> state(m_gates.size(), 0);
+    order.reserve(m_gates.size());
+    for (size_t root = 0; root < m_gates.size(); root++) {
+        if (state[root])
+            continue;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const int i = stack.back();
+            if (state[i] == 2) {
+                stack.pop_back();
+                continue;
+            }
+            bool ready = true;
+            if (!state[i]) {
+                state[i] = 1;
+                for (const auto input : m_gates[i]->get_PIs()) {
+                    const int j = defining[abs(input)];
+                    if (j >= 0 && !state[j])
+                        stack.push_back(j), ready = false;
+                }
+            }
+            if (!ready)
+                continue;
+            stack.pop_back();
+            state[i] = 2;
+            order.push_back(i);
+        }
+    }
+    return order;
+}
+
+void Circuit_Graph::simulate(const std::vector<int> &order, std::vector<uint64_t> &values) const {
+    assert(values.size() == (size_t) m_max_var + 1);
+    for (const auto i : order) {
+        const Circuit_LogicGate *gate = m_gates[i];
+        uint64_t v = ~(uint64_t) 0;
+        for (const auto input : gate->get_PIs()) {
+            const uint64_t w = values[abs(input)];
+            v &= input < 0 ? ~w : w;
+        }
+        values[gate->get_PO()] = v;
+    }
+}
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t circuit_hash_mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+// Inputs are hashed by their position and gates by the sorted literal
+// hashes of their inputs, which makes the hash independent of the order of
+// the gate inputs and of the numbering of the nodes.
+
+std::vector<uint64_t> Circuit_Graph::structural_hashes() const {
+    std::vector<uint64_t> hashes(m_max_var + 1, 0);
+    for (size_t i = 0; i < m_inputs.size(); i++)
+        hashes[m_inputs[i]] = circuit_hash_mix(i + 1) & ~(uint64_t) 1;
+    auto literal = [&hashes](int lit) {
+        return hashes[abs(lit)] | (lit < 0);
+    };
+    for (const auto i : topological_order()) {
+        const Circuit_LogicGate *gate = m_gates[i];
+        uint64_t h = 0x2545f4914f6cdd1dull;
+        std::vector<uint64_t> inputs;
+        for (const auto input : gate->get_PIs())
+            inputs.push_back(literal(input));
+        std::sort(inputs.begin(), inputs.end());
+        for (const auto input : inputs)
+            h = circuit_hash_mix(h ^ input);
+        hashes[gate->get_PO()] = (h | 2) & ~(uint64_t) 1;
+    }
+    return hashes;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Polarities are propagated from the outputs towards the inputs, where
+// negated edges swap the two bits.  The gates are not assumed to be in
+// topological order, thus a node is revisited whenever it gets a new bit.
+
+std::vector<signed char> Circuit_Graph::compute_polarities() const {
+    std::vector<int> defining(m_max_var + 1, -1);
+    for (size_t i = 0; i < m_gates.size(); i++)
+        defining[m_gates[i]->get_PO()] = i;
+
+    std::vector<signed char> polarities(m_max_var + 1, 0);
+    std::vector<int> stack;
+    auto use = [&](int lit, signed char polarity) {
+        if (lit < 0)
+            polarity = ((polarity & 1) << 1) | ((polarity & 2) >> 1);
+        const int idx = abs(lit);
+        if ((polarities[idx] | polarity) == polarities[idx])
+            return;
+        polarities[idx] |= polarity;
+        stack.push_back(idx);
+    };
+
+    for (const auto output : m_outputs)
+        use(output, 1);
+    while (!stack.empty()) {
+        const int idx = stack.back();
+        stack.pop_back();
+        if (defining[idx] < 0)
+            continue;
+        for (const auto input : m_gates[defining[idx]]->get_PIs())
+            use(input, polarities[idx]);
+    }
+    return polarities;
+}
+
+// The clauses of each gate 'out = a & b' are produced in the order
+//
+//   (-a -b out)  (-out a)  (-out b)
+//
+// which is also the numbering of the original clauses in circuit proofs.
+
+size_t Circuit_Graph::encode_cnf(bool plaisted_greenbaum,
+                                 const std::function<void(const std::vector<int> &)> &add) const {
+    std::vector<signed char> polarities;
+    if (plaisted_greenbaum)
+        polarities = compute_polarities();
+
+    size_t res = 0;
+    std::vector<int> clause;
+    for (const auto gate : m_gates) {
+        const int output = gate->get_PO();
+        const auto &inputs = gate->get_PIs();
+        const int polarity = plaisted_greenbaum ? polarities[output] : 3;
+        if (polarity & 2) {
+            clause.clear();
+            for (const auto input : inputs)
+                clause.push_back(-input);
+            clause.push_back(output);
+            add(clause), res++;
+        }
+        if (polarity & 1) {
+            for (const auto input : inputs) {
+                clause = {-output, input};
+                add(clause), res++;
+            }
+        }
+    }
+    for (const auto output : m_outputs) {
+        clause = {output};
+        add(clause), res++;
+    }
+    return res;
+}
+
 }
@@ -2,7 +2,9 @@
 #define _circuit_aig_hpp_INCLUDED
 
 #include <cstddef>
+#include <cstdint>
 #include <cassert>
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -37,9 +39,18 @@ public:
     std::string type() const override { return "AND"; }
 };
 
+// Latch of a sequential AIG with its next state function (as node id with
+// sign) and reset value (1 or -1, or 0 if the latch is uninitialized).
+struct Circuit_Latch {
+    int id;
+    int next;
+    signed char reset;
+};
+
 class Circuit_Graph {
 public:
-    Circuit_Graph(const int inputs_num, const int outputs_num, const int and_num) {
+    Circuit_Graph(const int max_var, const int inputs_num, const int outputs_num, const int and_num)
+        : m_max_var(max_var) {
         m_inputs.reserve(inputs_num);
         m_outputs.reserve(outputs_num);
         m_gates.reserve(and_num);
@@ -54,19 +65,65 @@ public:
     void add_input(const int input);
     void add_output(const int output);
     void add_and_gate(const int output, const std::vector<int> &inputs);
+    void add_latch(const int latch, const int next, const int reset);
+    void add_bad(const int bad);
+    void add_constraint(const int constraint);
 
+    int get_max_var()       const { return m_max_var; }
     int get_num_inputs()    const { return m_inputs.size(); }
     int get_num_outputs()   const { return m_outputs.size(); }
     int get_num_gates()     const { return m_gates.size(); }
+    int get_num_latches()   const { return m_latches.size(); }
 
     const std::vector<int> &get_inputs()                  const { return m_inputs; }
     const std::vector<int> &get_outputs()                 const { return m_outputs; }
     const std::vector<Circuit_LogicGate*> &get_gates()    const { return m_gates; }
+    const std::vector<Circuit_Latch> &get_latches()       const { return m_latches; }
+    const std::vector<int> &get_bad()                     const { return m_bad; }
+    const std::vector<int> &get_constraints()             const { return m_constraints; }
+
+    // Sequential AIGs (with latches or bad state properties) are checked by
+    // bounded model checking of the bad states instead of asserting the
+    // outputs (which are the bad states if there are no explicit ones).
+    bool is_sequential()    const { return !m_latches.empty() || !m_bad.empty(); }
+
+    // Number of gate inputs and outputs referring to each node, indexed by node id.
+    std::vector<int> compute_fanouts() const;
+
+    // Indices of the gates such that each gate comes after the gates
+    // defining its inputs (the AIG file does not need to be sorted).
+    std::vector<int> topological_order() const;
+
+    // Bit-parallel simulation of 64 patterns, where 'values' is indexed by
+    // node id, holds the patterns of the inputs (and latches) and gets the
+    // values of the gates computed in the topological 'order' given.
+    void simulate(const std::vector<int> &order, std::vector<uint64_t> &values) const;
+
+    // Structural hashes of the nodes indexed by node id, which only depend
+    // on the fanin cone of a node (and the positions of the inputs in it),
+    // such that the same node gets the same hash in another revision of the
+    // circuit.  Hashes are even and zero for unused ids, thus the hash of a
+    // literal is the hash of its node with the lowest bit as sign.
+    std::vector<uint64_t> structural_hashes() const;
+
+    // Polarities in which nodes are used by the outputs, indexed by node id:
+    // bit 0 if the node has to imply its inputs, bit 1 for the converse.
+    std::vector<signed char> compute_polarities() const;
+
+    // Pass the clauses of the Tseitin encoding (or the Plaisted-Greenbaum
+    // encoding restricted to the used polarities) followed by one unit per
+    // output to 'add' and return the number of clauses.
+    size_t encode_cnf(bool plaisted_greenbaum,
+                      const std::function<void(const std::vector<int> &)> &add) const;
 
 private:
+    int m_max_var;
     std::vector<int> m_inputs;
     std::vector<int> m_outputs;
     std::vector<Circuit_LogicGate*> m_gates;
+    std::vector<Circuit_Latch> m_latches;
+    std::vector<int> m_bad;
+    std::vector<int> m_constraints;
 };
 
 } // namespace CaDiCaL  
@@ -7,9 +7,19 @@ namespace CaDiCaL {
  */
 void Internal::circuit_learn_empty_clause() {
     assert (!unsat);
+    if (lrat && lrat_chain.empty () &&
+        (circuit_conflict_gate || circuit_conflict_direct[0])) {
+        assert (clause.empty ());
+        circuit_build_chain_for_conflict (circuit_conflict_gate, circuit_conflict_direct);
+    }
     LOG ("learned empty clause");
-
+    const uint64_t id = ++clause_id;
+    if (proof)
+        proof->add_derived_empty_clause (id, lrat_chain);
     unsat = true;
+    conflict_id = id;
+    conclusion.push_back (id);
+    lrat_chain.clear ();
 }
 
 /**
@@ -19,6 +29,11 @@ void Internal::circuit_learn_unit_clause(int lit) {
     assert (!unsat);
     assert (lit);
     LOG ("learned unit clause %d", lit);
+    const uint64_t id = ++clause_id;
+    unit_clauses[vlit (lit)] = id;
+    if (proof)
+        proof->add_derived_unit_clause (id, lit, lrat_chain);
+    lrat_chain.clear ();
     mark_fixed (lit);
 }
 
@@ -541,6 +556,10 @@ void Internal::circuit_analyze() {
     Circuit_Gate* reason = circuit_conflict_gate;
     std::array<int, 2>& reason_direct_array = circuit_conflict_direct;
 
+    // The loop below overwrites 'circuit_conflict_direct'.
+    //
+    const std::array<int, 2> conflict_direct = circuit_conflict_direct;
+
     const auto &t = &trail;
     int i = t->size();       // Start at end-of-trail;
     int open = 0;            // Seen but not processed on this level.
@@ -601,12 +620,16 @@ void Internal::circuit_analyze() {
             circuit_bump_variables();
     }
 
+    if (lrat)
+        circuit_build_chain_for_conflict(circuit_conflict_gate, conflict_direct);
+
     int jump;
     Circuit_Gate *driving_gate = circuit_new_driving_gate(glue, jump);
     UPDATE_AVERAGE (averages.current.jump, jump);
 
     int new_level = circuit_determine_actual_backtrack_level(jump);
     UPDATE_AVERAGE (averages.current.level, new_level);
+    circuit_save_trail(new_level, level - 1);  // without the conflict level
     circuit_backtrack(new_level);
 
     circuit_search_assign_driving(-uip, driving_gate, 0);
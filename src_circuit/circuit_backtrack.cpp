@@ -79,6 +79,7 @@ void Internal::circuit_backtrack(int new_level) {
         propagated = assigned;
     if (no_conflict_until > assigned)
         no_conflict_until = assigned;
+    circuit_restore_watches(new_level);
 
     control.resize(new_level + 1);
     level = new_level;
@@ -0,0 +1,236 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Bounded model checking of sequential AIGs.  The transition relation is
+// unrolled into the gate database incrementally, one frame per bound, and
+// the search for the new frame assumes that a bad state is reached in it.
+// Thus the gates learned for earlier bounds are kept, and after a bound is
+// shown to be safe the negation of its bad state literal is added as unit,
+// which is implied by the frames unrolled so far.
+//
+// Frame 0 uses the variables of the AIG nodes, where latches are fixed to
+// their reset values.  In later frames latches are replaced by the literals
+// of their next state functions in the previous frame, while inputs and AND
+// gates get fresh (external) variables.  Gates with identical inputs are replaced by
+// that input and those with complementary inputs by a root-level false
+// variable.  Invariant constraints are added as units in every frame, and
+// several bad state properties are combined by a disjunction.  Constant
+// next states, bad states and constraints are rejected by the parser.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Add the next frame of the transition relation.
+ * @return  false if the root level became inconsistent
+ */
+bool Internal::circuit_unroll() {
+    assert(!level);
+    assert(circuit_graph);
+    START (unroll);
+
+    const Circuit_Graph &graph = *circuit_graph;
+    const int frame = circuit_frame_bad.size();
+    if (circuit_bmc_order.empty())
+        circuit_bmc_order = graph.topological_order();
+
+    std::vector<int> map(graph.get_max_var() + 1, 0);
+    std::vector<std::array<int, 3>> gates;  // output, input1, input2
+    int next = max_var;
+
+    auto literal = [&map](int lit) {
+        const int res = map[abs(lit)];
+        assert(res);
+        return lit < 0 ? -res : res;
+    };
+    auto conjunction = [&](int a, int b, int node) {
+        if (a == b)
+            return a;
+        if (a == -b) {
+            if (!circuit_bmc_false)
+                circuit_bmc_false = ++next;
+            return circuit_bmc_false;
+        }
+        const int res = node && !frame ? node : ++next;
+        gates.push_back({res, a, b});
+        return res;
+    };
+
+    for (const auto input : graph.get_inputs())
+        map[input] = frame ? ++next : input;
+    for (const auto &latch : graph.get_latches()) {
+        if (!frame) {
+            map[latch.id] = latch.id;
+            continue;
+        }
+        const int lit = circuit_bmc_map[abs(latch.next)];
+        map[latch.id] = latch.next < 0 ? -lit : lit;
+    }
+    for (const auto i : circuit_bmc_order) {
+        const Circuit_LogicGate *gate = graph.get_gates()[i];
+        const auto &inputs = gate->get_PIs();
+        assert(inputs.size() == 2);
+        map[gate->get_PO()] = conjunction(literal(inputs[0]), literal(inputs[1]),
+                                          gate->get_PO());
+    }
+
+    int bad = 0;
+    for (const auto b : graph.get_bad()) {
+        const int lit = literal(b);
+        bad = bad ? -conjunction(-bad, -lit, 0) : lit;
+    }
+
+    std::vector<int> units;
+    if (!frame)
+        for (const auto &latch : graph.get_latches())
+            if (latch.reset)
+                units.push_back(latch.reset * latch.id);
+    for (const auto constraint : graph.get_constraints())
+        units.push_back(literal(constraint));
+    if (circuit_bmc_false > max_var)
+        units.push_back(-circuit_bmc_false);
+
+    external->init(next);
+    assert(max_var == next);
+
+    // New gates might contain literals already assigned at the root level,
+    // whose watches have to be propagated again.
+    //
+    size_t replay = propagated;
+    for (const auto &g : gates) {
+        circuit_add_original_gate(g[0], {g[1], g[2]});
+        for (const auto lit : g)
+            if (val(lit))
+                replay = std::min(replay, (size_t) var(lit).trail);
+    }
+    propagated = replay;
+    stats.circuitbmc.frames++;
+    stats.circuitbmc.gates += gates.size();
+
+    for (const auto lit : units) {
+        Flags &f = flags(lit);
+        if (f.status == Flags::UNUSED)
+            mark_active(abs(lit));
+        const signed char tmp = val(lit);
+        if (tmp < 0) {
+            circuit_learn_empty_clause();
+            break;
+        }
+        if (!tmp)
+            circuit_assign_unit(lit);
+    }
+    if (!unsat && !circuit_propagate())
+        circuit_learn_empty_clause();
+
+    std::vector<int> inputs;
+    for (const auto input : graph.get_inputs())
+        inputs.push_back(map[input]);
+    circuit_frame_inputs.push_back(std::move(inputs));
+    circuit_frame_bad.push_back(bad);
+    circuit_bmc_map = std::move(map);
+
+    VERBOSE (2, "unrolled frame %d with %zd gates", frame, gates.size());
+    STOP (unroll);
+    return !unsat;
+}
+
+/**
+ * @brief:  Save the counterexample ending in the last frame in AIGER
+ *          witness format.
+ */
+void Internal::circuit_bmc_extract_witness() {
+    const Circuit_Graph &graph = *circuit_graph;
+    auto value = [this](int lit) { return val(lit) > 0 ? '1' : '0'; };
+    auto last = [this](int lit) {
+        const int res = circuit_bmc_map[abs(lit)];
+        return lit < 0 ? -res : res;
+    };
+
+    circuit_bmc_witness.clear();
+    circuit_bmc_witness.push_back("1");
+    const auto &bad = graph.get_bad();
+    size_t property = 0;
+    while (property + 1 < bad.size() &&
+           value(last(bad[property])) != '1')
+        property++;
+    circuit_bmc_witness.push_back("b" + std::to_string(property));
+
+    std::string line;
+    for (const auto &latch : graph.get_latches())
+        line += latch.reset ? (latch.reset > 0 ? '1' : '0')
+                            : value(latch.id);
+    circuit_bmc_witness.push_back(line);
+    for (const auto &inputs : circuit_frame_inputs) {
+        line.clear();
+        for (const auto lit : inputs)
+            line += value(lit);
+        circuit_bmc_witness.push_back(line);
+    }
+    circuit_bmc_witness.push_back(".");
+}
+
+/**
+ * @brief:  Check whether a bad state is reachable within 'circuitbmc'
+ *          transitions, frame by frame starting after the last checked one.
+ * @return  10 if a bad state is reachable, 20 if not, and 0 if a limit
+ *          was hit (or while tracing proofs, which is not supported)
+ */
+int Internal::circuit_bmc() {
+    assert(!level);
+    if (proof) {
+        warning ("bounded model checking does not support proofs");
+        return 0;
+    }
+    if (!circuit_checkpoint_path.empty() || !circuit_resume_path.empty() ||
+        !circuit_lemma_path.empty()) {
+        warning ("ignoring checkpoints and lemma cache for sequential AIG");
+        circuit_checkpoint_path.clear();
+        circuit_resume_path.clear();
+        circuit_lemma_path.clear();
+    }
+
+    // Without latches all frames are identical.
+    //
+    const int bound = circuit_graph->get_num_latches() ? opts.circuitbmc : 0;
+
+    int res = 0;
+    while (!res) {
+        if (unsat) {
+            res = 20;
+            break;
+        }
+        const int frame = circuit_frame_bad.size();
+        if (frame > bound) {
+            MSG ("no bad state reachable within %d transitions", bound);
+            res = 20;
+            break;
+        }
+        if (!circuit_unroll())
+            continue;
+
+        const int bad = circuit_frame_bad.back();
+        assume(bad);
+        res = circuit_cdcl_loop_with_inprocessing();
+        reset_assumptions();
+        if (res == 10) {
+            MSG ("bad state reachable in frame %d", frame);
+            circuit_bmc_extract_witness();
+        } else if (res == 20 && !unsat) {
+            VERBOSE (1, "frame %d safe after %" PRId64 " conflicts",
+                     frame, stats.conflicts);
+            if (level)
+                circuit_backtrack();
+            if (!val(bad)) {
+                circuit_assign_unit(-bad);
+                if (!circuit_propagate())
+                    circuit_learn_empty_clause();
+            }
+            res = 0;
+        }
+    }
+    return res;
+}
+
+} // namespace CaDiCaL
@@ -0,0 +1,429 @@
+#include "../src/internal.hpp"
+
+#include <type_traits>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Checkpoints of the circuit engine allow to continue an interrupted run.
+// They are written at restarts (every 'circuitckptint' conflicts) into a
+// temporary file which is then renamed, such that a preempted job always
+// leaves a complete checkpoint behind.  A checkpoint contains the root-level
+// units, the learned gates (with glue and tier flags), the saved, target
+// and best phases, the EVSIDS scores and the VMTF queue, the limits and
+// the counters these limits depend on.  Original gates are not stored,
+// since they are parsed again, but a fingerprint of the AIG makes sure that
+// the checkpoint belongs to the same circuit (with outputs asserted or not).
+//
+// Restoring happens at the beginning of 'circuit_solve' (after the search
+// limits have been initialized), where conflict and decision limits of the
+// current run are kept but shifted by the restored number of conflicts and
+// decisions.  Since learned gates and units are not justified by a proof,
+// checkpoints are ignored while proofs are traced.  Checkpoints are written
+// in host byte order for the same build, which is checked through the sizes
+// of the copied structures.
+
+/*------------------------------------------------------------------------*/
+
+static const uint64_t circuit_checkpoint_magic = 0x3154504b43524943ull;  // "CIRCKPT1"
+
+struct Circuit_Checkpoint_Header {
+    uint64_t magic;
+    uint64_t fingerprint;
+    int32_t max_var;
+    uint32_t sizes[5];          // of the raw copied structures below
+};
+
+static_assert(std::is_trivially_copyable<Limit>::value, "raw copy of 'Limit'");
+static_assert(std::is_trivially_copyable<Last>::value, "raw copy of 'Last'");
+static_assert(std::is_trivially_copyable<Averages>::value, "raw copy of 'Averages'");
+static_assert(std::is_trivially_copyable<Reluctant>::value, "raw copy of 'Reluctant'");
+
+namespace {
+
+// Tiny helpers for reading and writing checkpoint files, where a failed
+// read or write sticks and is checked once at the end.
+
+struct Circuit_Checkpoint_File {
+    FILE *file;
+    bool ok = true;
+
+    Circuit_Checkpoint_File(FILE *f) : file(f) {}
+
+    void put(const void *ptr, size_t bytes) {
+        if (ok && bytes && fwrite(ptr, bytes, 1, file) != 1)
+            ok = false;
+    }
+    void get(void *ptr, size_t bytes) {
+        if (ok && bytes && fread(ptr, bytes, 1, file) != 1)
+            ok = false;
+    }
+    template <class T> void put(const T &t) { put(&t, sizeof t); }
+    template <class T> void get(T &t) { get(&t, sizeof t); }
+    template <class T> void put(const vector<T> &v) {
+        const uint64_t size = v.size();
+        put(size);
+        put(v.data(), size * sizeof(T));
+    }
+    template <class T> bool get(vector<T> &v, uint64_t limit) {
+        uint64_t size = 0;
+        get(size);
+        if (!ok || size > limit)
+            return ok = false;
+        v.resize(size);
+        get(v.data(), size * sizeof(T));
+        return ok;
+    }
+};
+
+} // namespace
+
+static void circuit_checkpoint_sizes(uint32_t sizes[5]) {
+    sizes[0] = sizeof(Limit);
+    sizes[1] = sizeof(Last);
+    sizes[2] = sizeof(Averages);
+    sizes[3] = sizeof(Reluctant);
+    sizes[4] = sizeof(Circuit_Gate);
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Hash of the parsed AIG (gates and outputs).
+ */
+uint64_t Internal::circuit_fingerprint() const {
+    uint64_t res = max_var;
+    auto hash = [&res](int64_t v) {
+        res ^= (uint64_t) v + 0x9e3779b97f4a7c15ull + (res << 6) + (res >> 2);
+    };
+    if (!circuit_graph)
+        return res;
+    for (const auto gate : circuit_graph->get_gates()) {
+        hash(gate->get_PO());
+        for (const auto input : gate->get_PIs())
+            hash(input);
+    }
+    for (const auto output : circuit_graph->get_outputs())
+        hash(output);
+    hash(opts.circuitoutputs);      // units depend on asserted outputs
+    return res;
+}
+
+/**
+ * @brief:  Enable writing checkpoints to 'path' (disabled for 0).
+ */
+void Internal::circuit_checkpoint_file(const char *path) {
+    circuit_checkpoint_path = path ? path : "";
+    lim.checkpoint = stats.conflicts + opts.circuitckptint;
+}
+
+/**
+ * @brief:  Restore the checkpoint in 'path' at the next 'circuit_solve'.
+ */
+void Internal::circuit_resume_file(const char *path) {
+    circuit_resume_path = path ? path : "";
+}
+
+bool Internal::circuit_checkpointing() {
+    if (circuit_checkpoint_path.empty())
+        return false;
+    return stats.conflicts >= lim.checkpoint;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Write a checkpoint (at a restart).
+ * @return  false if writing failed
+ */
+bool Internal::circuit_checkpoint() {
+    assert(!circuit_checkpoint_path.empty());
+    START (checkpoint);
+    lim.checkpoint = stats.conflicts + opts.circuitckptint;
+
+    const std::string tmp = circuit_checkpoint_path + ".tmp";
+    FILE *file = fopen(tmp.c_str(), "wb");
+    bool res = false;
+    if (file) {
+        Circuit_Checkpoint_File f(file);
+
+        Circuit_Checkpoint_Header header;
+        memset(&header, 0, sizeof header);
+        header.magic = circuit_checkpoint_magic;
+        header.fingerprint = circuit_fingerprint();
+        header.max_var = max_var;
+        circuit_checkpoint_sizes(header.sizes);
+        f.put(header);
+
+        f.put(lim), f.put(last), f.put(averages), f.put(reluctant);
+        f.put(inc.stabilize), f.put(inc.flush);
+        f.put(stable);
+        f.put(score_inc);
+        f.put(stats.conflicts), f.put(stats.decisions);
+        f.put(stats.restarts), f.put(stats.restartstable);
+        f.put(stats.stabphases), f.put(stats.reductions);
+        f.put(stats.probingphases), f.put(stats.subsumephases);
+        f.put(stats.bumped), f.put(stats.rephased);
+        f.put(queue.bumped);
+
+        vector<int> units, order;
+        for (auto idx : vars) {
+            const signed char v = val(idx);
+            if (v && !var(idx).level)
+                units.push_back(v < 0 ? -idx : idx);
+        }
+        for (int idx = queue.first; idx; idx = links[idx].next)
+            order.push_back(idx);
+        f.put(units);
+        f.put(order);
+        f.put(btab);
+        f.put(stab);
+        f.put(phases.saved);
+        f.put(phases.target);
+        f.put(phases.best);
+        f.put((uint64_t) target_assigned), f.put((uint64_t) best_assigned);
+
+        // Learned gates as size, glue, flags and literals.
+        //
+        uint64_t learned = 0;
+        for (const auto &g : circuit_gates)
+            learned += g->redundant && !g->garbage;
+        f.put(learned);
+        for (const auto &g : circuit_gates) {
+            if (!g->redundant || g->garbage)
+                continue;
+            const int32_t data[3] = {g->size, g->glue,
+                                     g->keep | (g->hyper << 1) | ((int) g->used << 2)};
+            f.put(data);
+            f.put(g->literals, g->size * sizeof(int));
+        }
+
+        res = f.ok;
+        if (fclose(file))
+            res = false;
+        if (res && rename(tmp.c_str(), circuit_checkpoint_path.c_str()))
+            res = false;
+        if (res) {
+            stats.circuitckpts++;
+            PHASE ("checkpoint", stats.circuitckpts,
+                   "wrote %" PRIu64 " learned gates and %zd units to '%s'",
+                   learned, units.size(), circuit_checkpoint_path.c_str());
+        }
+    }
+    if (!res) {
+        warning ("failed to write circuit checkpoint '%s'", circuit_checkpoint_path.c_str());
+        remove(tmp.c_str());
+    }
+    STOP (checkpoint);
+    return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Restore the checkpoint given by 'circuit_resume_file' once.
+ * @note:   Invalid or incompatible checkpoints are ignored with a warning,
+ *          i.e., solving starts from scratch.
+ */
+bool Internal::circuit_restore_checkpoint() {
+    const std::string path = circuit_resume_path;
+    circuit_resume_path.clear();
+    assert(!path.empty());
+    assert(!level);
+    if (proof) {
+        warning ("ignoring circuit checkpoint '%s' while tracing proofs", path.c_str());
+        return false;
+    }
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        warning ("can not read circuit checkpoint '%s'", path.c_str());
+        return false;
+    }
+    START (checkpoint);
+    Circuit_Checkpoint_File f(file);
+
+    Circuit_Checkpoint_Header header, expected;
+    memset(&expected, 0, sizeof expected);
+    expected.magic = circuit_checkpoint_magic;
+    expected.fingerprint = circuit_fingerprint();
+    expected.max_var = max_var;
+    circuit_checkpoint_sizes(expected.sizes);
+    f.get(header);
+    const char *error = 0;
+    if (!f.ok || header.magic != expected.magic)
+        error = "not a circuit checkpoint";
+    else if (memcmp(header.sizes, expected.sizes, sizeof header.sizes))
+        error = "written by an incompatible build";
+    else if (header.max_var != max_var || header.fingerprint != expected.fingerprint)
+        error = "written for a different circuit";
+
+    // Everything is read first and only applied if the file is complete.
+    //
+    Limit l;
+    Last la;
+    Averages a;
+    Reluctant r;
+    int64_t stabilize = 0, flush = 0, qbumped = 0;
+    bool s = false;
+    double sinc = 0;
+    int64_t counters[9];
+    decltype(stats.rephased) rephased;
+    vector<int> units, order;
+    vector<int64_t> b;
+    vector<double> sc;
+    vector<signed char> saved, target, best;
+    uint64_t tassigned = 0, bassigned = 0, learned = 0;
+    vector<int> gates;                  // size, glue, flags, literals...
+    const uint64_t n = max_var + 1;
+    if (!error) {
+        f.get(l), f.get(la), f.get(a), f.get(r);
+        f.get(stabilize), f.get(flush);
+        f.get(s);
+        f.get(sinc);
+        for (auto &c : counters)
+            f.get(c);
+        f.get(rephased);
+        f.get(qbumped);
+        f.get(units, n), f.get(order, n), f.get(b, n), f.get(sc, n);
+        f.get(saved, n), f.get(target, n), f.get(best, n);
+        f.get(tassigned), f.get(bassigned);
+        f.get(learned);
+        for (uint64_t i = 0; f.ok && i < learned; i++) {
+            int32_t data[3];
+            f.get(data);
+            if (!f.ok || data[0] < 2 || (uint64_t) data[0] > n) {
+                f.ok = false;
+                break;
+            }
+            gates.insert(gates.end(), data, data + 3);
+            const size_t offset = gates.size();
+            gates.resize(offset + data[0]);
+            f.get(&gates[offset], data[0] * sizeof(int));
+        }
+        if (!f.ok || b.size() != btab.size() || sc.size() != stab.size() ||
+            saved.size() != phases.saved.size() || target.size() != phases.target.size() ||
+            best.size() != phases.best.size())
+            error = "truncated or corrupted";
+    }
+    for (size_t i = 0; !error && i < gates.size(); i += 3 + gates[i])
+        for (int j = 0; !error && j < gates[i]; j++) {
+            const int lit = gates[i + 3 + j];
+            if (!lit || abs(lit) > max_var)
+                error = "corrupted gate";
+        }
+    for (size_t i = 0; !error && i < units.size(); i++)
+        if (!units[i] || abs(units[i]) > max_var)
+            error = "corrupted unit";
+    for (size_t i = 0; !error && i < order.size(); i++)
+        if (order[i] < 1 || order[i] > max_var)
+            error = "corrupted queue";
+    fclose(file);
+
+    if (error) {
+        warning ("ignoring circuit checkpoint '%s' (%s)", path.c_str(), error);
+        STOP (checkpoint);
+        return false;
+    }
+
+    // Limits and counters, where the conflict and decision limits of the
+    // current run are kept relative to the restored counters.
+    //
+    const int64_t conflicts = counters[0] - stats.conflicts;
+    const int64_t decisions = counters[1] - stats.decisions;
+    Limit keep = lim;
+    lim = l;
+    lim.initialized = keep.initialized;
+    lim.conflicts = keep.conflicts < 0 ? -1 : keep.conflicts + conflicts;
+    lim.decisions = keep.decisions < 0 ? -1 : keep.decisions + decisions;
+    lim.preprocessing = keep.preprocessing;
+    lim.localsearch = keep.localsearch;
+    lim.report = keep.report;
+    lim.terminate = keep.terminate;
+    last = la;
+    averages = a;
+    reluctant = r;
+    inc.stabilize = stabilize;
+    inc.flush = flush;
+    stable = s;
+    score_inc = sinc;
+    stats.conflicts = counters[0], stats.decisions = counters[1];
+    stats.restarts = counters[2], stats.restartstable = counters[3];
+    stats.stabphases = counters[4], stats.reductions = counters[5];
+    stats.probingphases = counters[6], stats.subsumephases = counters[7];
+    stats.bumped = counters[8];
+    stats.rephased = rephased;
+
+    phases.saved = saved;
+    circuit_phases_seeded = true;
+    phases.target = target;
+    phases.best = best;
+    target_assigned = tassigned;
+    best_assigned = bassigned;
+
+    // Scores and queue order (variables missing in 'order' stay in front).
+    //
+    stab = sc;
+    scores.clear();
+    for (auto idx : vars)
+        scores.push_back(idx);
+    btab = b;
+    vector<bool> enqueued(max_var + 1, false);
+    vector<int> rest;
+    for (const auto idx : order)
+        enqueued[idx] = true;
+    for (int idx = queue.first; idx; idx = links[idx].next)
+        if (!enqueued[idx])
+            rest.push_back(idx);
+    queue.first = queue.last = 0;
+    for (const auto idx : rest)
+        queue.enqueue(links, idx);
+    for (const auto idx : order)
+        queue.enqueue(links, idx);
+    queue.bumped = qbumped;
+    queue.unassigned = queue.last;
+
+    // Units and learned gates, where gates with root-level assigned
+    // literals are skipped (they are satisfied or would need shrinking).
+    //
+    size_t restored_units = 0, restored_gates = 0;
+    for (const auto lit : units) {
+        const signed char tmp = val(lit);
+        if (tmp > 0)
+            continue;
+        if (tmp < 0) {
+            circuit_learn_empty_clause();
+            break;
+        }
+        circuit_assign_unit(lit);
+        restored_units++;
+    }
+    if (!unsat && !circuit_propagate())
+        circuit_learn_empty_clause();
+    for (size_t i = 0; !unsat && i < gates.size(); i += 3 + gates[i]) {
+        const int size = gates[i], glue = gates[i + 1], flags = gates[i + 2];
+        const int *lits = &gates[i + 3];
+        bool skip = false;
+        for (int j = 0; !skip && j < size; j++)
+            skip = val(lits[j]);
+        if (skip)
+            continue;
+        assert(clause.empty());
+        clause.assign(lits, lits + size);
+        Circuit_Gate *g = circuit_new_gate(true, glue);
+        clause.clear();
+        g->keep = flags & 1;
+        g->hyper = (flags >> 1) & 1;
+        g->used = (flags >> 2) & 3;
+        circuit_watch_gate(g);
+        restored_gates++;
+    }
+
+    MSG ("resumed circuit checkpoint '%s' at %" PRId64 " conflicts "
+         "with %zd units and %zd of %" PRIu64 " learned gates",
+         path.c_str(), stats.conflicts, restored_units, restored_gates, learned);
+    STOP (checkpoint);
+    return true;
+}
+
+} // namespace CaDiCaL
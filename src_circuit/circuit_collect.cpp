@@ -40,6 +40,9 @@ void Internal::circuit_remove_watched_literals(Circuit_Gate* g) {
     if (num_non_watched < 2)
         return;
 
+    if (proof)
+        circuit_proof_flush_gate(g);
+
     circuit_literal_iterator j = g->begin();
     for (i = j; i != end; i++) {
         const int lit = *j++ = *i;
@@ -173,6 +176,16 @@ inline void Internal::circuit_flush_watches(int lit, Circuit_Watches &saved) {
     for (i = j; i != end; i++) {
         Circuit_Watch w = *i;
         Circuit_Gate *g = w.gate;
+        if (!circuit_permanent_dirty && circuit_permanent_gate(g)) {
+            // Unchanged since the last collection, thus the gate memory
+            // does not have to be accessed.
+            //
+            if (w.binary())
+                *j++ = w;
+            else
+                saved.push_back(w);
+            continue;
+        }
         if (g->collect())
             continue;
         if (g->moved)
@@ -200,6 +213,8 @@ inline void Internal::circuit_flush_watches(int lit, Circuit_Watches &saved) {
 void Internal::circuit_flush_all_occs_and_watches() {
     // remove watch for garbage learnt gate
     if (circuit_watching()) {
+        circuit_restore_watches();          // suspended watches too
+        circuit_clear_saved_trail();        // saved reasons
         Circuit_Watches tmp;
         for (auto idx : vars) {
             circuit_flush_watches(idx, tmp);
@@ -222,7 +237,7 @@ void Internal::circuit_update_reason_references() {
             continue;
         Var &v = var(lit);
         Circuit_Gate *g = v.circuit_reason;
-        if (!g)
+        if (!g || circuit_permanent_gate(g))
             continue;
         assert(g->reason);
         assert(g->moved);
@@ -247,13 +262,17 @@ void Internal::circuit_delete_garbage_gates() {
 #ifndef QUIET
     int64_t collected_bytes = 0, collected_clauses = 0;
 #endif
+    bool pending = false;       // garbage permanent gates still reasons
     const auto end = circuit_gates.end();
     auto j = circuit_gates.begin(), i = j;
     while (i != end) {
         Circuit_Gate *g = *j++ = *i++;
         assert (g);
-        if (!g->collect())
+        if (!g->collect()) {
+            if (g->garbage && circuit_permanent_gate(g))
+                pending = true;
             continue;
+        }
 #ifndef QUIET
         collected_bytes += g->bytes ();
         collected_clauses++;
@@ -263,6 +282,7 @@ void Internal::circuit_delete_garbage_gates() {
     }
     circuit_gates.resize(j - circuit_gates.begin());
     shrink_vector(circuit_gates);
+    circuit_permanent_dirty = pending;
 
     PHASE ("collect", stats.collections,
            "collected %" PRId64 " bytes of %" PRId64 " garbage clauses",
@@ -282,6 +302,35 @@ void Internal::circuit_copy_gate(Circuit_Gate *g) {
         (void *) g->copy);
 }
 
+/**
+ * @brief:  Copy the original gates once to the permanent region, which is
+ *          never moved again.  Later collections only move learned gates
+ *          and do not access unchanged permanent gates at all.
+ */
+void Internal::circuit_copy_permanent_gates() {
+    assert(!circuit_permanent_built);
+    circuit_permanent_built = true;
+
+    size_t bytes = 0, count = 0;
+    for (const auto &g : circuit_gates)
+        if (!g->redundant && !g->collect())
+            bytes += g->bytes(), count++;
+
+    circuit_permanent.prepare(bytes);
+    for (const auto &g : circuit_gates) {
+        if (g->redundant || g->collect())
+            continue;
+        g->copy = (Circuit_Gate *) circuit_permanent.copy((char *) g, g->bytes());
+        g->moved = true;
+    }
+    circuit_permanent.swap();
+
+    PHASE ("collect", stats.collections,
+           "copied %zd bytes of %zd original gates to permanent region",
+           bytes, count);
+    (void) count;
+}
+
 /**
  * @note:   collect.cpp:  copy_non_garbage_clauses()
  */
@@ -289,9 +338,14 @@ void Internal::circuit_copy_non_garbage_gates() {
     size_t collected_clauses = 0, collected_bytes = 0;
     size_t moved_clauses = 0, moved_bytes = 0;
 
+    if (!circuit_permanent_built)
+        circuit_copy_permanent_gates();
+
     // First determine 'moved_bytes' and 'collected_bytes'.
     //
     for (const auto &g : circuit_gates) {
+        if (circuit_permanent_gate(g) || g->moved)
+            continue;
         if (!g->collect()) {
             moved_bytes += g->bytes(), moved_clauses++;
         } else {
@@ -311,13 +365,13 @@ void Internal::circuit_copy_non_garbage_gates() {
     //
     if (opts.arenacompact)
         for (const auto &g : circuit_gates)
-            if (!g->collect() && arena.contains(g))
+            if (arena.contains(g) && !g->collect())
                 circuit_copy_gate(g);
 
     if (opts.arenatype == 1 || !circuit_watching()) {
         // Localize according to current clause order.
         for (const auto &g : circuit_gates)
-            if (!g->moved && !g->collect())
+            if (!circuit_permanent_gate(g) && !g->moved && !g->collect())
                 circuit_copy_gate(g);
 
     } else if (opts.arenatype == 2) {
@@ -325,7 +379,8 @@ void Internal::circuit_copy_non_garbage_gates() {
         for (int sign = 1; sign >= -1; sign -= 2)
             for (auto idx : vars)
                 for (const auto &w : circuit_watches(sign * circuit_likely_phase (idx)))
-                    if (!w.gate->moved && !w.gate->collect())
+                    if (!circuit_permanent_gate(w.gate) && !w.gate->moved &&
+                        !w.gate->collect())
                         circuit_copy_gate(w.gate);
 
     } else {
@@ -334,13 +389,14 @@ void Internal::circuit_copy_non_garbage_gates() {
         for (int sign = 1; sign >= -1; sign -= 2)
             for (int idx = queue.last; idx; idx = link(idx).prev)
                 for (const auto &w : circuit_watches(sign * circuit_likely_phase (idx)))
-                    if (!w.gate->moved && !w.gate->collect())
+                    if (!circuit_permanent_gate(w.gate) && !w.gate->moved &&
+                        !w.gate->collect())
                         circuit_copy_gate(w.gate);
 
     }
 
     for (const auto &g : circuit_gates)
-        if (!g->collect() && !g->moved)
+        if (!circuit_permanent_gate(g) && !g->collect() && !g->moved)
             circuit_copy_gate(g);
 
     circuit_flush_all_occs_and_watches();
@@ -348,11 +404,20 @@ void Internal::circuit_copy_non_garbage_gates() {
 
     // Replace and flush clause references in 'clauses'.
     //
+    bool pending = false;       // garbage permanent gates still reasons
     const auto end = circuit_gates.end();
     auto j = circuit_gates.begin(), i = j;
     for (; i != end; i++) {
         Circuit_Gate *g = *i;
-        if (g->collect()) {
+        if (circuit_permanent_gate(g)) {
+            if (circuit_permanent_dirty && g->collect())
+                circuit_delete_gate(g);
+            else {
+                if (g->garbage)
+                    pending = true;
+                *j++ = g;
+            }
+        } else if (g->collect()) {
             circuit_delete_gate(g);
         } else {
             assert(g->moved);
@@ -364,6 +429,11 @@ void Internal::circuit_copy_non_garbage_gates() {
     if (circuit_gates.size() < circuit_gates.capacity() / 2)
         shrink_vector(circuit_gates);
 
+    // Permanent gates which are garbage but still protected reasons are
+    // only flushed (and their watches) by a later collection.
+    //
+    circuit_permanent_dirty = pending;
+
     if (opts.arenasort)
         rsort(circuit_gates.begin(), circuit_gates.end(), pointer_rank ());
 
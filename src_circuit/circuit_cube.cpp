@@ -0,0 +1,352 @@
+#include "../src/internal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Cube-and-conquer for circuit instances.  Cubes are generated by splitting
+// on primary inputs and high-fanout internal nodes of the parsed AIG, where
+// each candidate is scored by the number of propagated literals of both of
+// its phases (the usual product heuristic of look-ahead solvers).  The
+// cubes are then solved by a pool of independent circuit engines, which
+// are all initialized from the same read-only 'circuit_graph'.  Idle
+// workers steal cubes from the back of the queue of other workers.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Primary inputs and high-fanout internal nodes sorted by fanout.
+ */
+std::vector<int> Internal::circuit_cube_candidates() {
+    assert(circuit_graph);
+    const std::vector<int> fanouts = circuit_graph->compute_fanouts();
+    std::vector<char> candidate(max_var + 1, 0);
+    for (const auto input : circuit_graph->get_inputs())
+        candidate[input] = 1;
+    for (const auto gate : circuit_graph->get_gates()) {
+        const int idx = gate->get_PO();
+        if (fanouts[idx] >= opts.circuitcubefanout)
+            candidate[idx] = 1;
+    }
+
+    std::vector<int> res;
+    for (auto idx : vars)
+        if (candidate[idx] && active(idx))
+            res.push_back(idx);
+
+    stable_sort(res.begin(), res.end(), [&fanouts](int a, int b) {
+        return fanouts[a] > fanouts[b];
+    });
+    if (res.size() > (size_t) opts.circuitcubeprobes)
+        res.resize(opts.circuitcubeprobes);
+
+    LOG ("found %zd cube split candidates", res.size());
+    return res;
+}
+
+/**
+ * @brief:  Find the best splitting literal under the current assignment.
+ * @note:   lookahead.cpp: lookahead_probing()
+ * @return  0 if all candidates are assigned
+ */
+int Internal::circuit_lookahead_split(const std::vector<int> &candidates) {
+    assert(propagated == trail.size());
+
+    int res = 0;
+    int64_t best = -1;
+
+    for (const auto idx : candidates) {
+        if (terminated_asynchronously())
+            break;
+        if (val(idx))
+            continue;
+
+        int64_t score = 1;
+        int64_t propagated_pos = 0;
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            const int lit = sign * idx;
+            const size_t before = trail.size();
+            circuit_search_assume_decision(lit);
+            int64_t delta;
+            if (circuit_propagate())
+                delta = trail.size() - before;
+            else {
+                LOG ("lookahead literal %d fails", lit);
+                delta = max_var;    // closes the branch immediately
+            }
+            circuit_backtrack(level - 1);
+            circuit_conflict_clear();
+            score *= delta + 1;
+            if (sign > 0)
+                propagated_pos = delta;
+        }
+
+        if (score <= best)
+            continue;
+        best = score;
+
+        // Take the phase which propagates more first.
+        //
+        res = (2 * propagated_pos + 1 >= score / (propagated_pos + 1)) ? idx : -idx;
+    }
+
+    LOG ("lookahead split literal %d with score %" PRId64, res, best);
+    return res;
+}
+
+/**
+ * @brief:  Breadth first generation of cubes up to the given depth.
+ * @note:   lookahead.cpp: generate_cubes()
+ */
+CubesWithStatus Internal::circuit_generate_cubes(int depth) {
+    CubesWithStatus res;
+    res.status = 0;
+
+    if (unsat) {
+        res.status = 20;
+        return res;
+    }
+
+    START (lookahead);
+    if (level)
+        circuit_backtrack();
+    if (!circuit_propagate()) {
+        circuit_learn_empty_clause();
+        res.status = 20;
+        STOP (lookahead);
+        return res;
+    }
+
+    const std::vector<int> candidates = circuit_cube_candidates();
+    std::vector<std::vector<int>> cubes{std::vector<int>()};
+
+    for (int i = 0; i < depth && !terminated_asynchronously(); i++) {
+        std::vector<std::vector<int>> cubes2{std::move(cubes)};
+        cubes.clear();
+
+        for (auto &cube : cubes2) {
+            assert(!level);
+            bool failed = false;
+            for (const auto lit : cube) {
+                const signed char tmp = val(lit);
+                if (tmp > 0)
+                    continue;
+                if (tmp < 0 || (circuit_search_assume_decision(lit),
+                                !circuit_propagate())) {
+                    failed = true;
+                    break;
+                }
+            }
+
+            const int split = failed ? 0 : circuit_lookahead_split(candidates);
+            circuit_backtrack();
+            circuit_conflict_clear();
+
+            if (failed) {
+                LOG ("cube at depth %d is unsatisfiable; dropping", i);
+                continue;
+            }
+
+            if (!split) {
+                cubes.push_back(std::move(cube));
+                continue;
+            }
+
+            std::vector<int> cube1{cube};
+            cube1.push_back(split);
+            cube.push_back(-split);
+            cubes.push_back(std::move(cube1));
+            cubes.push_back(std::move(cube));
+        }
+
+        PHASE ("cube", i + 1, "generated %zd cubes at depth %d",
+               cubes.size(), i + 1);
+    }
+
+    STOP (lookahead);
+
+    if (cubes.empty()) {
+        LOG ("all cubes unsatisfiable");
+        circuit_learn_empty_clause();
+        res.status = 20;
+    } else
+        res.cubes = std::move(cubes);
+
+    return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+namespace {
+
+// Workers only read the shared 'done' flag.  The external terminator of the
+// master is polled by the coordinating thread alone, which sets 'done'.
+//
+struct Circuit_Cube_Terminator : public Terminator {
+    std::atomic<bool> &done;
+    Circuit_Cube_Terminator(std::atomic<bool> &d) : done(d) {}
+    bool terminate () override { return done; }
+};
+
+struct Circuit_Cube_Queue {
+    std::mutex lock;
+    std::deque<size_t> cubes;
+};
+
+} // namespace
+
+/**
+ * @brief:  Solve the cubes with a work-stealing pool of circuit engines.
+ * @return  10 with saved phases set to the model, 20 if all cubes are
+ *          unsatisfiable, and 0 if interrupted
+ */
+int Internal::circuit_solve_cubes(const std::vector<std::vector<int>> &cubes) {
+    assert(circuit_graph);
+
+    unsigned threads = opts.circuitcubethreads;
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
+    if (threads > cubes.size())
+        threads = cubes.size();
+
+    PHASE ("cube", stats.conflicts,
+           "solving %zd cubes with %u threads", cubes.size(), threads);
+
+    std::vector<Circuit_Cube_Queue> queues(threads);
+    for (size_t i = 0; i < cubes.size(); i++)
+        queues[i % threads].cubes.push_back(i);
+
+    std::atomic<bool> done(false);
+    std::atomic<unsigned> finished(0);
+    std::atomic<size_t> unsatisfiable(0), stolen(0);
+    std::mutex model_lock;
+    std::vector<signed char> model;
+
+    auto next_cube = [&](unsigned worker, size_t &cube) {
+        {
+            Circuit_Cube_Queue &own = queues[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.cubes.empty()) {
+                cube = own.cubes.front();
+                own.cubes.pop_front();
+                return true;
+            }
+        }
+        for (unsigned i = 1; i < threads; i++) {
+            Circuit_Cube_Queue &victim = queues[(worker + i) % threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.cubes.empty())
+                continue;
+            cube = victim.cubes.back();
+            victim.cubes.pop_back();
+            stolen++;
+            return true;
+        }
+        return false;
+    };
+
+    auto work = [&](unsigned worker) {
+        Circuit_Cube_Terminator terminator(done);
+        size_t cube;
+        while (!done && next_cube(worker, cube)) {
+            Solver *solver = new Solver();
+            Internal *other = solver->internal;
+            opts.copy(other->opts);
+            other->opts.circuitcube = 0;
+            other->opts.quiet = 1;
+            other->opts.report = 0;
+            other->opts.verbose = 0;
+            solver->reserve(max_var);
+            other->circuit_init(circuit_graph);
+            for (const auto lit : cubes[cube]) {
+                if (other->unsat)
+                    break;
+                const signed char tmp = other->val(lit);
+                if (tmp > 0)
+                    continue;
+                if (tmp < 0)
+                    other->circuit_learn_empty_clause();
+                else
+                    other->circuit_assign_original_unit(++other->clause_id, lit);
+            }
+            int res = 20;
+            if (!other->unsat) {
+                solver->connect_terminator(&terminator);
+                res = solver->solve();
+                solver->disconnect_terminator();
+            }
+            if (res == 10) {
+                std::lock_guard<std::mutex> guard(model_lock);
+                if (!done) {
+                    model.resize(max_var + 1);
+                    for (int idx = 1; idx <= max_var; idx++)
+                        model[idx] = solver->val(idx) > 0 ? 1 : -1;
+                    done = true;
+                }
+            } else if (res == 20)
+                unsatisfiable++;
+            delete solver;
+        }
+        finished++;
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++)
+        pool.emplace_back(work, i);
+    while (finished < threads) {
+        if (!done && terminated_asynchronously())
+            done = true;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    for (auto &thread : pool)
+        thread.join();
+
+    PHASE ("cube", stats.conflicts,
+           "%zd cubes unsatisfiable, %zd cubes stolen",
+           (size_t) unsatisfiable, (size_t) stolen);
+
+    if (!model.empty()) {
+        for (auto idx : vars)
+            phases.saved[idx] = model[idx];
+        return 10;
+    }
+    if (unsatisfiable == cubes.size())
+        return 20;
+    return 0;
+}
+
+/**
+ * @brief:  Split the instance into cubes and solve them in parallel.
+ * @return  10 or 20 if solved and 0 otherwise (then continue with CDCL)
+ */
+int Internal::circuit_cube_and_conquer() {
+    assert(opts.circuitcube > 0);
+    if (!circuit_graph)
+        return 0;
+
+    CubesWithStatus cubes = circuit_generate_cubes(opts.circuitcube);
+    if (cubes.status)
+        return cubes.status;
+    if (terminated_asynchronously())
+        return 0;
+
+    int res = circuit_solve_cubes(cubes.cubes);
+    if (res == 10) {
+        res = circuit_try_to_satisfy_formula_by_saved_phases();
+        if (!res)
+            LOG ("cube model does not satisfy the learned gates");
+    } else if (res == 20)
+        circuit_learn_empty_clause();
+    report ('c');
+    return res;
+}
+
+} // namespace CaDiCaL
@@ -38,13 +38,127 @@ int Internal::circuit_likely_phase(int idx) { return circuit_decide_phase(idx, f
  * @note:   decide.cpp: satisfied()
  */
 bool Internal::circuit_satisfied() {
+    if ((size_t) level < assumptions.size())
+        return false;
     if (num_assigned < (size_t) max_var)
         return false;
     assert(num_assigned == (size_t) max_var);
     if (propagated < trail.size ())
         return false;
     size_t assigned = num_assigned;
-    return (assigned = (size_t) max_var);
+    return (assigned == (size_t) max_var);
+}
+
+/**
+ * @note:   only for combinational circuits (unrolled frames are not nodes)
+ *          and not after enumeration, since completing a justified
+ *          assignment might hit a blocked cube, nor after it failed once
+ */
+bool Internal::circuit_justifying() {
+    return opts.circuitjustify && circuit_graph && !circuit_graph->is_sequential() &&
+           !circuit_blocking && !circuit_justify_failed;
+}
+
+/**
+ * @brief:  check whether all original units (the outputs) and assumptions
+ *          are justified by the current partial assignment, i.e., are true
+ *          and recursively true AND gates have all and false AND gates at
+ *          least one input justified down to the primary inputs.
+ * @param:  cube    if non-zero collects the justifying input literals
+ * @note:   unassigned nodes outside of the justified cones are don't-cares
+ *          and all other (learned) gates are implied by the original ones
+ */
+bool Internal::circuit_justified(std::vector<int> *cube) {
+    assert(circuit_graph);
+    const Circuit_Graph &graph = *circuit_graph;
+    const auto &gates = graph.get_gates();
+    if (circuit_defining_gates.empty()) {
+        circuit_defining_gates.assign(max_var + 1, -1);
+        for (size_t i = 0; i < gates.size(); i++)
+            circuit_defining_gates[gates[i]->get_PO()] = i;
+    }
+    if (circuit_justify_stamps.empty())
+        circuit_justify_stamps.assign(max_var + 1, 0);
+    const int64_t stamp = ++circuit_justify_stamp;
+    stats.circuitjustify.checks++;
+
+    auto &stack = circuit_justify_stack;
+    stack.clear();
+    for (const auto lit : circuit_original_units)
+        stack.push_back(lit);
+    for (const auto lit : assumptions)
+        stack.push_back(lit);
+
+    while (!stack.empty()) {
+        const int lit = stack.back();
+        stack.pop_back();
+        if (val(lit) <= 0)
+            return false;
+        const int idx = abs(lit);
+        if (circuit_justify_stamps[idx] == stamp)
+            continue;
+        circuit_justify_stamps[idx] = stamp;
+        const int g = circuit_defining_gates[idx];
+        if (g < 0) {
+            if (cube)
+                cube->push_back(lit);
+            continue;                           // input
+        }
+        const auto &inputs = gates[g]->get_PIs();
+        if (lit > 0) {
+            for (const auto input : inputs)
+                stack.push_back(input);
+            continue;
+        }
+        // Prefer a false input which is already justified.
+        int justification = 0;
+        for (const auto input : inputs) {
+            if (val(input) >= 0)
+                continue;
+            justification = -input;
+            if (circuit_justify_stamps[abs(input)] == stamp)
+                break;
+        }
+        if (!justification)
+            return false;
+        stack.push_back(justification);
+    }
+    return true;
+}
+
+/**
+ * @brief:  complete a justified partial assignment by simulating the
+ *          circuit (unassigned inputs get their saved phase) and replay
+ *          the resulting model as decisions.
+ * @return  10 (the model satisfies all gates including learned ones) and
+ *          otherwise 0 to fall back to the normal search, where completing
+ *          justified assignments is disabled from then on
+ */
+int Internal::circuit_satisfy_justified() {
+    const Circuit_Graph &graph = *circuit_graph;
+    std::vector<uint64_t> values(graph.get_max_var() + 1, 0);
+    for (const auto input : graph.get_inputs()) {
+        const signed char tmp = val(input);
+        values[input] = (tmp ? tmp : circuit_likely_phase(input)) > 0 ? ~(uint64_t) 0 : 0;
+    }
+    graph.simulate(graph.topological_order(), values);
+
+    LOG ("completing justified assignment at level %d with %zd of %d assigned",
+         level, num_assigned, max_var);
+    for (int idx = 1; idx < (int) values.size(); idx++)
+        phases.saved[idx] = values[idx] ? 1 : -1;
+    circuit_backtrack();
+    const int res = circuit_try_to_satisfy_formula_by_saved_phases();
+    if (res != 10) {
+        VERBOSE (2, "completing justified assignment failed "
+                 "(falling back to search)");
+        if (level)
+            circuit_backtrack();
+        circuit_justify_failed = true;
+        return 0;
+    }
+    stats.circuitjustify.satisfied++;
+    return res;
 }
 
 /**
@@ -54,17 +168,36 @@ bool Internal::circuit_satisfied() {
 int Internal::circuit_decide() {
     assert(!circuit_satisfied());
     START (decide);
+    int res = 0;
 
-    int idx = next_decision_variable();
+    // Assumptions are decided first, one per decision level, with pseudo
+    // decision levels for assumptions already satisfied.
+    //
+    if ((size_t) level < assumptions.size()) {
+        const int lit = assumptions[level];
+        const signed char tmp = val(lit);
+        if (tmp < 0) {
+            LOG ("assumption %d falsified", lit);
+            res = 20;
+        } else if (tmp > 0) {
+            LOG ("assumption %d already satisfied", lit);
+            new_trail_level(0);
+        } else {
+            LOG ("deciding assumption %d", lit);
+            circuit_search_assume_decision(lit);
+        }
+    } else {
+        int idx = next_decision_variable();
 
-    const bool target = (opts.target > 1 || (stable && opts.target));
-    int decision = circuit_decide_phase(idx, target);
+        const bool target = (opts.target > 1 || (stable && opts.target));
+        int decision = circuit_decide_phase(idx, target);
 
-    circuit_search_assume_decision(decision);
-    stats.decisions++;
+        circuit_search_assume_decision(decision);
+        stats.decisions++;
+    }
 
     STOP (decide);
-    return 0;
+    return res;
 }
 
 }  // namespace CaDiCaL
@@ -83,6 +83,15 @@ void Internal::circuit_mark_duplicated_binary_clauses_as_garbage() {
                     circuit_mark_garbage(c);
                     j--;
                 } else if (tmp < 0) {
+                    if (lrat) {
+                        for (auto k = ws.begin(); k != j; k++) {
+                            if (!k->binary() || k->blit != -other || k->gate->garbage)
+                                continue;
+                            lrat_chain.push_back(k->gate->id);
+                            break;
+                        }
+                        lrat_chain.push_back(c->id);
+                    }
                     unit = -lit;
                     units++;
                     while (i != end) {
@@ -0,0 +1,108 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Enumeration of the satisfying input patterns (AllSAT).  After each model
+// the primary inputs justifying the outputs are collected as cube, i.e.,
+// every input pattern extending the cube satisfies the outputs.  The cube
+// is written as one line over the inputs (in AIGER order) with '0', '1' and
+// 'x' for don't-cares and then blocked by an irredundant gate over its
+// literals (the nogood of the cube) added at the root level.  The search
+// continues right away with all learned gates, scores and phases.  Cubes
+// may overlap, but each one contains at least the last model which is not
+// covered by previous cubes, thus enumeration terminates with the circuit
+// and its blocking gates being unsatisfiable.
+//
+// Since blocking gates are not implied by the circuit, completing justified
+// partial assignments is disabled once enumeration added them.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Block the input cube by a gate (the nogood of the cube) added at
+ *          the root level, where root-level true literals are dropped.
+ */
+void Internal::circuit_block_cube(const std::vector<int> &cube) {
+    if (level)
+        circuit_backtrack();
+    circuit_blocking = true;
+
+    assert(clause.empty());
+    for (const auto lit : cube) {
+        const int value = fixed(lit);
+        assert(value >= 0);
+        if (!value)
+            clause.push_back(lit);
+    }
+    stats.circuitenum.literals += clause.size();
+    LOG (clause, "blocking cube");
+
+    if (clause.empty())
+        circuit_learn_empty_clause();
+    else if (clause.size() == 1) {
+        circuit_assign_unit(-clause[0]);
+        if (!circuit_propagate())
+            circuit_learn_empty_clause();
+    } else {
+        Circuit_Gate *g = circuit_new_gate(false, clause.size());
+        circuit_watch_gate(g);
+    }
+    clause.clear();
+}
+
+/**
+ * @brief:  Enumerate cubes of input patterns satisfying the circuit and
+ *          write them to 'file' until all are blocked or 'circuitenum'
+ *          cubes are written.
+ * @return  20 if all satisfying patterns are covered, 10 if the cube limit
+ *          was reached and 0 if the search was interrupted by limits
+ */
+int Internal::circuit_enumerate(FILE *file) {
+    assert(circuit_graph && !circuit_graph->is_sequential());
+    assert(assumptions.empty());
+    START (solve);
+    init_preprocessing_limits();
+    init_search_limits();
+    if (level)
+        circuit_backtrack();
+
+    const auto &inputs = circuit_graph->get_inputs();
+    std::vector<int> cube;
+    std::string line;
+    int res = unsat ? 20 : circuit_lucky_phases();
+    for (;;) {
+        if (!res)
+            res = circuit_cdcl_loop_with_inprocessing();
+        if (res != 10)
+            break;
+
+        cube.clear();
+        const bool justified = circuit_justified(&cube);
+        assert(justified), (void) justified;
+        line.assign(inputs.size(), 'x');
+        for (size_t i = 0; i < inputs.size(); i++) {
+            const int idx = inputs[i];
+            if (circuit_justify_stamps[idx] == circuit_justify_stamp)
+                line[i] = val(idx) > 0 ? '1' : '0';
+        }
+        fprintf(file, "%s\n", line.c_str());
+        stats.circuitenum.cubes++;
+
+        circuit_block_cube(cube);
+        if (opts.circuitenum && stats.circuitenum.cubes >= opts.circuitenum)
+            break;
+        res = 0;
+    }
+    fflush(file);
+
+    MSG ("enumerated %" PRId64 " cubes with %.2f literals on average (%s)",
+         stats.circuitenum.cubes,
+         relative (stats.circuitenum.literals, stats.circuitenum.cubes),
+         res == 20 ? "complete" : "incomplete");
+    STOP (solve);
+    return res;
+}
+
+} // namespace CaDiCaL
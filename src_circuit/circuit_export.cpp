@@ -0,0 +1,184 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Export of the simplified circuit.  The current graph (after rewriting)
+// is written as AIG, where nodes fixed at the root level are substituted
+// by constants, AND gates are simplified and structurally hashed and logic
+// outside of the cones of the outputs is dropped.  Since root-level units
+// are only implied under the asserted outputs, a fixed node whose
+// simplified function is not constant is kept as additional output
+// asserting its value, such that the exported circuit is satisfiable
+// exactly by the input patterns satisfying the original outputs.  Inputs
+// are kept (unless fixed) even if not used anymore, and outputs simplified
+// to true are dropped.  An inconsistent circuit is written as a single
+// false output.
+//
+// The comment section maps the nodes of the original (parsed) AIG to
+// literals of the exported one, one '<node> <literal>' line per node still
+// represented, where '0' and '1' are the constants.  Nodes removed by
+// rewriting or dropped as dangling logic are omitted.  The file is written
+// in binary AIGER format if 'path' ends with '.aig' and in ASCII otherwise.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Write the simplified circuit with root-level units substituted
+ *          together with the node map to 'path'.
+ * @return  error message or zero on success
+ */
+const char *Internal::circuit_write_aig(const char *path) {
+    if (!circuit_graph)
+        return error_message.init ("no circuit to export");
+    const Circuit_Graph &graph = *circuit_graph;
+    if (graph.is_sequential())
+        return error_message.init ("can not export sequential AIG");
+
+    // Exported AIGER literals of the graph nodes, where new AND gates are
+    // numbered in the order they are created and renumbered at the end.
+    //
+    const int max_node = graph.get_max_var();
+    std::vector<unsigned> map(max_node + 1, 0);
+    std::vector<bool> mapped(max_node + 1, false);
+    std::vector<std::array<unsigned, 2>> ands;
+    std::unordered_map<uint64_t, unsigned> strash;
+    std::vector<unsigned> outputs;
+    bool inconsistent = unsat;
+
+    unsigned inputs = 0;
+    for (const auto input : graph.get_inputs()) {
+        const int value = fixed(input);
+        map[input] = value ? (value > 0) : 2 * ++inputs;
+        mapped[input] = true;
+    }
+    auto literal = [&](int lit) {
+        assert(mapped[abs(lit)]);
+        return map[abs(lit)] ^ (lit < 0);
+    };
+    auto conjunction = [&](unsigned a, unsigned b) -> unsigned {
+        if (a < b)
+            std::swap(a, b);
+        if (!b || a == (b ^ 1))
+            return 0;
+        if (b == 1 || a == b)
+            return a;
+        const uint64_t key = (uint64_t) a << 32 | b;
+        const auto it = strash.find(key);
+        if (it != strash.end())
+            return it->second;
+        const unsigned res = 2 * (inputs + 1 + ands.size());
+        ands.push_back({a, b});
+        strash[key] = res;
+        return res;
+    };
+    auto assert_true = [&](unsigned lit) {
+        if (!lit)
+            inconsistent = true;
+        else if (lit != 1)
+            outputs.push_back(lit);
+    };
+
+    const auto &gates = graph.get_gates();
+    for (const auto i : graph.topological_order()) {
+        const int out = gates[i]->get_PO();
+        const auto &fanins = gates[i]->get_PIs();
+        unsigned lit = conjunction(literal(fanins[0]), literal(fanins[1]));
+        if (const int value = fixed(out)) {
+            assert_true(value > 0 ? lit : lit ^ 1);
+            lit = value > 0;
+        }
+        map[out] = lit;
+        mapped[out] = true;
+    }
+    for (const auto output : graph.get_outputs())
+        assert_true(literal(output));
+
+    // Dangling gates are dropped while renumbering the remaining ones, where
+    // fanins come before the gates using them, as required by AIGER.
+    //
+    if (inconsistent)
+        outputs = {0}, ands.clear(), inputs = 0;
+    std::vector<unsigned> number(ands.size(), 0);
+    std::vector<bool> used(ands.size(), false);
+    auto gate = [inputs](unsigned lit) { return (long) (lit / 2) - inputs - 1; };
+    for (const auto lit : outputs)
+        if (gate(lit) >= 0)
+            used[gate(lit)] = true;
+    for (size_t i = ands.size(); i-- > 0;)
+        if (used[i])
+            for (const auto lit : ands[i])
+                if (gate(lit) >= 0)
+                    used[gate(lit)] = true;
+    unsigned count = 0;
+    for (size_t i = 0; i < ands.size(); i++)
+        if (used[i])
+            number[i] = 2 * (inputs + 1 + count++);
+    auto renumber = [&](unsigned lit) {
+        const long i = gate(lit);
+        return i < 0 ? lit : (used[i] ? number[i] | (lit & 1) : ~0u);
+    };
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return error_message.init ("failed to write AIG '%s'", path);
+    const size_t len = strlen(path);
+    const bool binary = len >= 4 && !strcmp(path + len - 4, ".aig");
+    const unsigned max_lit = inputs + count;
+    fprintf(file, "%s %u %u 0 %zd %u\n", binary ? "aig" : "aag", max_lit,
+            inputs, outputs.size(), count);
+    if (!binary)
+        for (unsigned i = 1; i <= inputs; i++)
+            fprintf(file, "%u\n", 2 * i);
+    for (const auto lit : outputs)
+        fprintf(file, "%u\n", renumber(lit));
+    for (size_t i = 0; i < ands.size(); i++) {
+        if (!used[i])
+            continue;
+        const unsigned lhs = number[i];
+        const unsigned rhs0 = renumber(ands[i][0]), rhs1 = renumber(ands[i][1]);
+        assert(lhs > rhs0 && rhs0 >= rhs1);
+        if (!binary) {
+            fprintf(file, "%u %u %u\n", lhs, rhs0, rhs1);
+            continue;
+        }
+        for (unsigned delta : {lhs - rhs0, rhs0 - rhs1}) {
+            while (delta & ~0x7fu) {
+                fputc((delta & 0x7f) | 0x80, file);
+                delta >>= 7;
+            }
+            fputc(delta, file);
+        }
+    }
+
+    // Nodes removed by rewriting are not in the graph and the map of the
+    // rewritten graph is the identity otherwise.  All nodes of an
+    // inconsistent circuit are dropped.
+    //
+    fputs("c\nnode map from original variables to exported literals\n", file);
+    const int original = circuit_rewrite_map.empty()
+                             ? max_node : (int) circuit_rewrite_map.size() - 1;
+    int64_t represented = 0;
+    for (int idx = 1; idx <= original; idx++) {
+        const int lit = circuit_rewrite_map.empty() ? idx : circuit_rewrite_map[idx];
+        if (inconsistent || !lit || !mapped[abs(lit)])
+            continue;
+        const unsigned res = renumber(literal(lit));
+        if (res == ~0u)
+            continue;
+        fprintf(file, "%d %u\n", idx, res);
+        represented++;
+    }
+    if (fclose(file))
+        return error_message.init ("failed to write AIG '%s'", path);
+
+    MSG ("exported circuit with %u inputs, %zd outputs and %u AND gates "
+         "(%d before) to '%s'", inputs, outputs.size(), count,
+         graph.get_num_gates(), path);
+    VERBOSE (2, "node map represents %" PRId64 " of %d original nodes",
+             represented, original);
+    return 0;
+}
+
+} // namespace CaDiCaL
@@ -0,0 +1,202 @@
+#include "../src/internal.hpp"
+
+#include <cmath>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Automatic engine selection ('satsolvermode=0').  Right after parsing an
+// AIG a few cheap structural features are computed in linear time and the
+// graph is simulated with random 64-bit parallel input patterns.  A small
+// linear model over the features then picks the circuit engine or the CNF
+// engine and a configuration preset.  The features and the decision are
+// printed in one line each, such that the weights of the model can be
+// refit offline from the logs of many runs.
+
+/*------------------------------------------------------------------------*/
+
+Circuit_Features Internal::circuit_compute_features(const Circuit_Graph &graph) {
+    Circuit_Features res;
+    const int max_node = graph.get_max_var();
+    const auto &gates = graph.get_gates();
+    const auto &inputs = graph.get_inputs();
+    const auto &outputs = graph.get_outputs();
+
+    res.inputs = graph.get_num_inputs();
+    res.outputs = graph.get_num_outputs();
+    res.gates = graph.get_num_gates();
+    res.io_ratio = res.inputs / (double) max(1, res.outputs);
+
+    std::vector<int> defining(max_node + 1, -1);
+    for (size_t i = 0; i < gates.size(); i++)
+        defining[gates[i]->get_PO()] = i;
+    const std::vector<int> order = graph.topological_order();
+
+    std::vector<int> depth(max_node + 1, 0);
+    for (const auto i : order) {
+        int d = 0;
+        for (const auto input : gates[i]->get_PIs())
+            d = max(d, depth[abs(input)]);
+        depth[gates[i]->get_PO()] = ++d;
+        res.depth = max(res.depth, d);
+    }
+
+    // An XOR (or XNOR) of 'a' and 'b' is 'AND(-AND(a,b), -AND(-a,-b))' (or
+    // with 'b' negated), thus the inputs of the two inner gates are
+    // pairwise complementary.
+    //
+    int xors = 0;
+    for (const auto gate : gates) {
+        const auto &pis = gate->get_PIs();
+        if (pis.size() != 2 || pis[0] > 0 || pis[1] > 0)
+            continue;
+        const int x = defining[-pis[0]], y = defining[-pis[1]];
+        if (x < 0 || y < 0)
+            continue;
+        const auto &a = gates[x]->get_PIs(), &b = gates[y]->get_PIs();
+        if (a.size() != 2 || b.size() != 2)
+            continue;
+        if ((a[0] == -b[0] && a[1] == -b[1]) || (a[0] == -b[1] && a[1] == -b[0]))
+            xors++;
+    }
+    if (res.gates)
+        res.xor_ratio = min(1.0, 3.0 * xors / res.gates);
+
+    const std::vector<int> fanouts = graph.compute_fanouts();
+    int64_t sum = 0, multi = 0;
+    auto count_fanout = [&](int idx) {
+        const int fanout = fanouts[idx];
+        sum += fanout;
+        multi += (fanout > 1);
+        res.max_fanout = max(res.max_fanout, fanout);
+    };
+    for (const auto input : inputs)
+        count_fanout(input);
+    for (const auto gate : gates)
+        count_fanout(gate->get_PO());
+    const int nodes = res.inputs + res.gates;
+    if (nodes) {
+        res.mean_fanout = sum / (double) nodes;
+        res.multi_fanout_ratio = multi / (double) nodes;
+    }
+
+    // Random simulation.  Without any satisfying pattern the likelihood is
+    // estimated by assuming the outputs to be independent, with add-one
+    // smoothing such that never satisfied outputs do not give zero.
+    //
+    std::vector<uint64_t> values(max_node + 1, 0);
+    std::vector<int64_t> output_true(outputs.size(), 0);
+    auto value = [&values](int lit) {
+        const uint64_t v = values[abs(lit)];
+        return lit < 0 ? ~v : v;
+    };
+    Random random(opts.seed);
+    for (int round = 0; round < opts.circuitsimrounds && res.gates; round++) {
+        for (const auto input : inputs)
+            values[input] = random.next();
+        graph.simulate(order, values);
+        uint64_t all = ~(uint64_t) 0;
+        for (size_t k = 0; k < outputs.size(); k++) {
+            const uint64_t v = value(outputs[k]);
+            output_true[k] += __builtin_popcountll(v);
+            all &= v;
+        }
+        res.patterns += 64;
+        if (!all)
+            continue;
+        res.hits += __builtin_popcountll(all);
+        if (!res.witness.empty())
+            continue;
+        const int bit = __builtin_ctzll(all);
+        res.witness.resize(max_node + 1, 0);
+        for (int idx = 1; idx <= max_node; idx++)
+            res.witness[idx] = (values[idx] >> bit) & 1 ? 1 : -1;
+    }
+    if (res.hits)
+        res.sat_likelihood = res.hits / (double) res.patterns;
+    else if (res.patterns) {
+        res.sat_likelihood = 1;
+        for (const auto count : output_true)
+            res.sat_likelihood *= (count + 1) / (double) (res.patterns + 2);
+    }
+
+    MSG ("circuit features: inputs=%d outputs=%d gates=%d depth=%d "
+         "xor=%.3f maxfanout=%d meanfanout=%.3f multifanout=%.3f io=%.3f "
+         "patterns=%" PRId64 " hits=%" PRId64 " satlikelihood=%.3g",
+         res.inputs, res.outputs, res.gates, res.depth, res.xor_ratio,
+         res.max_fanout, res.mean_fanout, res.multi_fanout_ratio, res.io_ratio,
+         res.patterns, res.hits, res.sat_likelihood);
+
+    return res;
+}
+
+/**
+ * @brief:  Apply a configuration preset but keep options which were set by
+ *          the user (i.e., differ from their default value).
+ * @note:   config.cpp: Config::set()
+ */
+void Internal::circuit_apply_preset(const char *name) {
+    std::vector<std::pair<Option *, int>> kept;
+    for (Option *o = Options::begin(); o != Options::end(); o++)
+        if (o->val(&opts) != o->def)
+            kept.push_back({o, o->val(&opts)});
+    Config::set(opts, name);
+    for (const auto &p : kept)
+        p.first->val(&opts) = p.second;
+}
+
+/**
+ * @brief:  Set 'satsolvermode' (and a preset) from the features.
+ * @return  the selected mode
+ */
+int Internal::circuit_select_engine(const Circuit_Features &features) {
+    assert(!opts.satsolvermode);
+
+    int mode;
+    const char *preset = nullptr;
+    double score = 0;
+
+    if (features.hits) {
+        // Proven satisfiable by simulation, the circuit engine is started
+        // with the witness as saved phases.
+        //
+        mode = 1;
+    } else {
+        // Initial weights, meant to be refit from logged features.
+        //
+        score = 0.5
+              - 1.5 * features.xor_ratio
+              + 1.0 * features.multi_fanout_ratio
+              - 0.1 * log2(1.0 + features.io_ratio)
+              - 0.02 * features.depth / log2(2.0 + features.gates);
+        mode = score > 0 ? 1 : 3;
+        if (features.patterns && features.sat_likelihood < 1e-9)
+            preset = "unsat";
+        else if (features.sat_likelihood > 1e-2)
+            preset = "sat";
+    }
+
+    opts.satsolvermode = mode;
+    if (preset)
+        circuit_apply_preset(preset);
+
+    MSG ("circuit engine selection: score=%.3f mode=%d (%s) preset=%s",
+         score, mode, mode == 1 ? "circuit" : "cadical",
+         preset ? preset : "none");
+
+    return mode;
+}
+
+/**
+ * @brief:  Use the node values of a simulated satisfying pattern as saved
+ *          phases of the circuit engine.
+ */
+void Internal::circuit_seed_phases(const std::vector<signed char> &witness) {
+    circuit_phases_seeded = true;
+    for (auto idx : vars)
+        if (idx < (int) witness.size() && witness[idx])
+            phases.saved[idx] = witness[idx];
+}
+
+} // namespace CaDiCaL
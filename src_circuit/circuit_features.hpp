@@ -0,0 +1,33 @@
+#ifndef _circuit_features_hpp_INCLUDED
+#define _circuit_features_hpp_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Cheap structural and simulation features of a parsed AIG, computed once
+// right after parsing to select the engine (see 'circuit_features.cpp').
+
+struct Circuit_Features {
+    int inputs = 0;
+    int outputs = 0;
+    int gates = 0;
+    int depth = 0;                      // longest path from an input
+
+    double xor_ratio = 0;               // fraction of gates in XOR/XNOR patterns
+    int max_fanout = 0;
+    double mean_fanout = 0;             // over inputs and gates
+    double multi_fanout_ratio = 0;      // nodes with more than one fanout
+    double io_ratio = 0;                // inputs per output
+
+    int64_t patterns = 0;               // simulated random input patterns
+    int64_t hits = 0;                   // patterns satisfying all outputs
+    double sat_likelihood = 0;          // estimated from the simulation
+
+    std::vector<signed char> witness;   // node values of a satisfying pattern
+};
+
+} // namespace CaDiCaL
+
+#endif // _circuit_features_hpp_INCLUDED
@@ -85,7 +85,7 @@ Circuit_Gate* Internal::circuit_new_gate(bool red, int glue) {
     g->reason = false;
     g->redundant = red;
     g->transred = false;
-    g->subsume = false;
+    g->subsume = true;
     g->used = 0;
 
     g->glue = glue;
@@ -94,8 +94,10 @@ Circuit_Gate* Internal::circuit_new_gate(bool red, int glue) {
 
     for (int i = 0; i < size; i++)
         g->literals[i] = clause[i];
+    g->update_signature();
 
     assert(g->bytes() == bytes);
+    circuit_account_gate(g, bytes);
 
     stats.current.total++;
     stats.added.total++;
@@ -171,8 +173,13 @@ size_t Internal::circuit_shrink_gate( Circuit_Gate *g, int new_size) {
 
     size_t old_bytes = g->bytes();
     g->size = new_size;
+    g->subsume = true;
+    g->update_signature();
+    if (circuit_permanent_gate(g))
+        circuit_permanent_dirty = true;
     size_t new_bytes = g->bytes();
     size_t res = old_bytes - new_bytes;
+    circuit_account_gate(g, - (int64_t) res);
 
     if (g->redundant) {
         circuit_promote_gate(g, min(g->size - 1, g->glue));
@@ -194,7 +201,7 @@ size_t Internal::circuit_shrink_gate( Circuit_Gate *g, int new_size) {
  */
 void Internal::circuit_deallocate_gate(Circuit_Gate *g) {
     char *p = (char*)g;
-    if (arena.contains(p))
+    if (arena.contains(p) || circuit_permanent.contains(p))
         return;
     delete[] p;
 }
@@ -204,6 +211,12 @@ void Internal::circuit_deallocate_gate(Circuit_Gate *g) {
  * @note:    clause.cpp: delete_clause()
  */
 void Internal::circuit_delete_gate(Circuit_Gate *g) {
+    // Binary gates are traced as deleted only when they are actually
+    // deleted, since garbage binary gates might still be propagated.
+    //
+    if (proof && g->garbage && g->size == 2)
+        circuit_proof_delete_gate(g);
+    circuit_account_gate(g, - (int64_t) g->bytes());
     circuit_deallocate_gate(g);
 }
 
@@ -215,6 +228,9 @@ void Internal::circuit_delete_gate(Circuit_Gate *g) {
 void Internal::circuit_mark_garbage(Circuit_Gate* g) {
     assert(!g->garbage);
 
+    if (proof && g->size != 2)
+        circuit_proof_delete_gate(g);
+
     assert (stats.current.total > 0);
     stats.current.total--;
 
@@ -234,6 +250,8 @@ void Internal::circuit_mark_garbage(Circuit_Gate* g) {
     stats.garbage.literals += g->size;
     g->garbage = true;
     g->used = 0;
+    if (circuit_permanent_gate(g))
+        circuit_permanent_dirty = true;
 
 //    LOG (g, "marked garbage pointer %p", (void *) g);
 }
@@ -243,7 +261,7 @@ void Internal::circuit_mark_garbage(Circuit_Gate* g) {
  * @note:   clause.cpp: assign_original_unit()
  * @param   lit (gate_id * gate_val)
  */
-void Internal::circuit_assign_original_unit(int lit) {
+void Internal::circuit_assign_original_unit(uint64_t id, int lit) {
     assert (!level);
     assert (!unsat);
     const int idx = vidx(lit);
@@ -258,6 +276,8 @@ void Internal::circuit_assign_original_unit(int lit) {
     circuit_set_val(idx, tmp);
     trail.push_back(lit);
     num_assigned++;
+    unit_clauses[vlit(lit)] = id;
+    circuit_original_units.push_back(lit);
     LOG ("original unit assign %d", lit);
     assert(num_assigned == trail.size());
     mark_fixed(lit);
@@ -277,6 +297,9 @@ void Internal::circuit_assign_original_unit(int lit) {
 Circuit_Gate *Internal::circuit_new_learned_redundant_gate(int glue) {
     assert(clause.size () > 1);
     auto res = circuit_new_gate(true, glue);
+    if (proof)
+        circuit_proof_add_derived_gate(res);
+    lrat_chain.clear();
 
     /// add watch
     circuit_watch_gate(res);
@@ -290,6 +313,9 @@ Circuit_Gate *Internal::circuit_new_learned_redundant_gate(int glue) {
 Circuit_Gate *Internal::circuit_new_hyper_binary_resolved_clause(bool red, int glue) {
     assert(clause.size() == 2);
     auto res = circuit_new_gate(red, glue);
+    if (proof)
+        circuit_proof_add_derived_gate(res);
+    lrat_chain.clear();
 
     assert(circuit_watching());
     // add watch
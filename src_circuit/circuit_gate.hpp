@@ -2,6 +2,8 @@
 #define _circuit_gate_hpp_INCLUDED
 
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
 
 namespace CaDiCaL {
 
@@ -21,13 +23,15 @@ struct Circuit_Gate {
     bool reason : 1;                                    /// reason / antecedent clause can not be collected
     bool redundant : 1;                                 /// aka 'learned' so not 'irredundant' (original)
     bool transred : 1;                                  /// already checked for transitive reduction
-    bool subsume : 1;                                   /// not checked in last subsumption round
+    bool subsume : 1;                                   /// added or shrunk since last checked
     unsigned used : 2;                                  /// resolved in conflict analysis since last 'reduce'
 
     int glue;                                           /// glue/lbd
     int size;
     int pos;                                            /// Position of last watch replacement [Gent'13].
 
+    uint64_t signature;                                 /// variables as 64-bit Bloom filter for subsumption
+
     int literals[];   /// 1. original gates: {input_1 * watch_value_1, input_2 * watch_value_2,...,output * watch_value}
                       /// 2. learned gates:  {input_1 * watch_value_1, input_2 * watch_value_2,...,input_n * watch_value_n}
 
@@ -48,6 +52,19 @@ struct Circuit_Gate {
     size_t bytes() const { return bytes(size); }
 
     bool collect() const { return !reason && garbage; }
+
+    // Variable (not literal) based, such that a gate can only subsume or
+    // strengthen another gate if its signature is a subset.
+    //
+    static uint64_t signature_bit(int lit) {
+        const uint32_t hash = (uint32_t) abs(lit) * 0x9e3779b1u;
+        return (uint64_t) 1 << (hash >> 26);
+    }
+    void update_signature() {
+        signature = 0;
+        for (const auto &lit : *this)
+            signature |= signature_bit(lit);
+    }
 };
 
 } // namespace CaDiCaL
@@ -0,0 +1,129 @@
+#include "../src/internal.hpp"
+
+#include <sstream>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Per-node hints computed outside of the solver (signal probabilities,
+// predicted phases, criticality) seed the decision heuristics.  The hint
+// file has one line per AIG node (its AIGER variable index, i.e., literal
+// divided by two) with an activity score, a phase and an optional decision
+// priority (default 0), where empty lines and lines starting with 'c' or
+// '#' are skipped:
+//
+//   <node> <score> <phase> [<priority>]
+//
+// Nodes with higher priority are decided before those with lower priority
+// and within the same priority those with higher score first.  This order
+// seeds both the score heap (focused on in stable mode) and the VMTF queue
+// (in unstable mode), where hinted nodes come before all other nodes.  A
+// phase of 1 or -1 sets the initial (saved) phase, while 2 or -2 forces the
+// phase for all decisions on the node ('0' keeps the default phase).
+//
+// Nodes refer to the original circuit.  If rewriting replaced a node the
+// hint applies to the replacing literal (with its phase flipped if that
+// literal is negative) and hints on nodes removed by rewriting are skipped.
+
+/*------------------------------------------------------------------------*/
+
+struct Circuit_Hint {
+    int idx;
+    double score;
+    int phase;
+    int priority;
+};
+
+/**
+ * @brief:  Read hints from 'path' and apply them to the decision heuristics
+ *          of the circuit engine.
+ * @return  error message or zero on success
+ */
+const char *Internal::circuit_read_hints(const char *path) {
+    std::ifstream file(path);
+    if (!file.good())
+        return error_message.init ("failed to read hint file '%s'", path);
+
+    std::vector<Circuit_Hint> hints;
+    int lineno = 0;
+    for (std::string line; std::getline(file, line);) {
+        lineno++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == 'c' || line[first] == '#')
+            continue;
+        std::istringstream fields(line);
+        Circuit_Hint hint{0, 0, 0, 0};
+        std::string rest;
+        if (!(fields >> hint.idx >> hint.score >> hint.phase) ||
+            (!(fields >> hint.priority) && !fields.eof()) || (fields >> rest))
+            return error_message.init ("invalid hint in line %d of '%s'", lineno, path);
+        const int original = circuit_rewrite_map.empty()
+                                 ? max_var : (int) circuit_rewrite_map.size() - 1;
+        if (hint.idx < 1 || hint.idx > original)
+            return error_message.init ("invalid node %d in line %d of '%s'",
+                                       hint.idx, lineno, path);
+        if (hint.score < 0 || hint.phase < -2 || hint.phase > 2 || hint.priority < 0)
+            return error_message.init ("hint out of range in line %d of '%s'",
+                                       lineno, path);
+        hints.push_back(hint);
+    }
+
+    // Map original nodes to the rewritten graph.
+    //
+    size_t removed = 0;
+    if (!circuit_rewrite_map.empty()) {
+        size_t j = 0;
+        for (auto hint : hints) {
+            const int lit = circuit_rewrite_map[hint.idx];
+            if (!lit) {
+                removed++;
+                continue;
+            }
+            hint.idx = abs(lit);
+            if (lit < 0)
+                hint.phase = -hint.phase;
+            hints[j++] = hint;
+        }
+        hints.resize(j);
+    }
+
+    // Scores of higher priorities are shifted beyond all lower scores.
+    //
+    double offset = 1;
+    for (const auto &hint : hints)
+        offset = std::max(offset, hint.score + 1);
+    std::stable_sort(hints.begin(), hints.end(),
+                     [](const Circuit_Hint &a, const Circuit_Hint &b) {
+                         if (a.priority != b.priority)
+                             return a.priority < b.priority;
+                         return a.score < b.score;
+                     });
+
+    size_t phased = 0;
+    for (const auto &hint : hints) {
+        const int idx = hint.idx;
+        stab[idx] = hint.score + hint.priority * offset;
+        if (scores.contains(idx))
+            scores.update(idx);
+        if (opts.bump)
+            bump_queue(idx);        // last bumped is decided first
+        if (!hint.phase)
+            continue;
+        const signed char phase = hint.phase < 0 ? -1 : 1;
+        phases.saved[idx] = phase;
+        if (abs(hint.phase) > 1)
+            phases.forced[idx] = phase;
+        phased++;
+    }
+
+    if (phased)
+        circuit_phases_seeded = true;
+    MSG ("applied %zd hints with %zd phases from '%s'",
+         hints.size(), phased, path);
+    if (removed)
+        VERBOSE (1, "skipped %zd hints on nodes removed by rewriting", removed);
+    return 0;
+}
+
+} // namespace CaDiCaL
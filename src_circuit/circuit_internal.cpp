@@ -2,33 +2,91 @@
 
 namespace CaDiCaL {
 
+/**
+ * @brief:  Add the AND gate 'output = AND(inputs)' as original gate, which
+ *          is watched and added to the direct implication graph.
+ */
+Circuit_Gate *Internal::circuit_add_original_gate(int output, const std::vector<int> &inputs) {
+    auto mark_flag_func = [this](int id) {
+        Flags &f = flags (id);
+        if (f.status == Flags::UNUSED)
+            mark_active (id);
+        else if (f.status != Flags::ACTIVE && f.status != Flags::FIXED)
+            reactivate (id);
+    };
+
+    for (const auto input : inputs)
+        mark_flag_func(abs(input));
+    mark_flag_func(abs(output));
+
+    assert(clause.empty());
+    // watch_value of and-gate: 0(output), 1(input1), 1(input2)
+    // if input has inverter, watch_value is inverted
+    // if output has inverter, watch_value is inverted
+    // Identical inputs would be watched twice, thus such a gate is an
+    // equivalence with a binary gate.
+    //
+    clause = inputs;
+    if (clause.size() == 2 && clause[0] == clause[1])
+        clause.pop_back();
+    clause.push_back(output * -1);
+
+    auto cur_gate_info_ptr = circuit_new_gate(false, clause.size());
+    clause.clear();
+
+    if (proof)
+        circuit_proof_add_original_gate(cur_gate_info_ptr);
+
+    // 把input1和input2作为监视指针，并把其放入监视列表
+    circuit_watch_gate(cur_gate_info_ptr);
+
+    // 构建直接蕴含图
+    circuit_watch_gate_direct(cur_gate_info_ptr);
+
+    return cur_gate_info_ptr;
+}
+
 void Internal::circuit_init(const Circuit_Graph *graph_ptr) {
-    assert (circuit_wtab.size() == (size_t)(2 * (max_var + 1)));
-    assert (circuit_dwtab.size() == (size_t)(2 * (max_var + 1)));
+    assert (circuit_wtab.size() >= (size_t)(2 * (max_var + 1)));
+    assert (circuit_dwtab.size() >= (size_t)(2 * (max_var + 1)));
 
     // 确定每个gate监视值和监视指针、并把其放入监视列表
     const auto &gates = graph_ptr->get_gates();
-    for (const auto &gate : gates) {
-        assert(clause.empty());
-        // watch_value of and-gate: 0(output), 1(input1), 1(input2)
-        // if input has inverter, watch_value is inverted
-        // if output has inverter, watch_value is inverted
-        clause = gate->get_PIs();
-        clause.push_back(gate->get_PO() * -1);
-
-        auto cur_gate_info_ptr = circuit_new_gate(false, clause.size());
-        clause.clear();
-
-        // 把input1和input2作为监视指针，并把其放入监视列表
-        circuit_watch_gate(cur_gate_info_ptr);
-
-        // 构建直接蕴含图
-        circuit_watch_gate_direct(cur_gate_info_ptr);
-    }
-
+    for (const auto &gate : gates)
+        circuit_add_original_gate(gate->get_PO(), gate->get_PIs());
+
+    // Without asserted outputs (in server mode) queries constrain the
+    // circuit only by assumptions.
+    //
+    if (!opts.circuitoutputs)
+        return;
+
+    // All output units get their ids before any of them is propagated such
+    // that the original clauses are numbered consecutively.
+    //
     const auto& outputs = graph_ptr->get_outputs();
+    vector<uint64_t> ids;
     for (const auto output : outputs) {
-        circuit_assign_original_unit(output);
+        const uint64_t id = ++clause_id;
+        if (proof)
+            proof->add_original_clause(id, false, {output});
+        ids.push_back(id);
+    }
+    for (size_t i = 0; !unsat && i < outputs.size(); i++) {
+        const int output = outputs[i];
+        if (flags(output).status == Flags::UNUSED)
+            mark_active(abs(output));       // output is an input
+        const signed char tmp = val(output);
+        if (tmp > 0)
+            continue;
+        if (tmp < 0) {
+            if (lrat) {
+                lrat_chain.push_back(unit_clauses[vlit(-output)]);
+                lrat_chain.push_back(ids[i]);
+            }
+            circuit_learn_empty_clause();
+        } else
+            circuit_assign_original_unit(ids[i], output);
     }
 }
 
@@ -38,12 +96,67 @@ void Internal::circuit_init(const Circuit_Graph *graph_ptr) {
 int Internal::circuit_solve() {
     START (solve);
 
-    int result = circuit_cdcl_loop_with_inprocessing();
+    int result = 0;
+    if (level)
+        circuit_backtrack();
+    if (circuit_graph && circuit_graph->is_sequential()) {
+        result = circuit_bmc();
+        STOP (solve);
+        return result;
+    }
+    if (!circuit_resume_path.empty())
+        circuit_restore_checkpoint();
+    if (!circuit_lemma_path.empty() && !circuit_lemmas_loaded && !unsat)
+        circuit_load_lemmas();
+    if (unsat)
+        result = 20;
+    else
+        result = circuit_lucky_phases();
+    if (!result && opts.circuitcube && circuit_graph && !proof &&
+        assumptions.empty())
+        result = circuit_cube_and_conquer();
+    if (!result)
+        result = circuit_cdcl_loop_with_inprocessing();
+    if (!circuit_lemma_path.empty())
+        circuit_save_lemmas();
 
     STOP (solve);
     return result;
 }
 
+/**
+ * @brief:  replay the saved phases as decisions (used to import models)
+ * @note:   internal.cpp:   try_to_satisfy_formula_by_saved_phases()
+ */
+int Internal::circuit_try_to_satisfy_formula_by_saved_phases() {
+    LOG ("satisfying circuit by saved phases");
+    assert (!level);
+    assert (!force_saved_phase);
+    if (!circuit_propagate()) {
+        circuit_learn_empty_clause();
+        return 20;
+    }
+    force_saved_phase = true;
+    int res = 0;
+    while (!res) {
+        if (circuit_satisfied()) {
+            LOG ("circuit indeed satisfied by saved phases");
+            res = 10;
+        } else if (circuit_decide()) {
+            res = 20;
+        } else if (!circuit_propagate()) {
+            LOG ("saved phases do not satisfy learned gates");
+            assert (level > 0);
+            circuit_backtrack();
+            circuit_conflict_clear();   // ignore conflict
+            break;
+        }
+    }
+    assert (force_saved_phase);
+    force_saved_phase = false;
+    return res;
+}
+
 /**
  * @brief:  the main CDCL loop
  * @note:   internal.cpp:   cdcl_loop_with_inprocessing()
@@ -69,6 +182,8 @@ int Internal::circuit_cdcl_loop_with_inprocessing() {
             circuit_iterate();                      // report learnt unit
         } else if (circuit_satisfied()) {
             res = 10;                               // already satisfied
+        } else if (circuit_justifying() && circuit_justified()) {
+            res = circuit_satisfy_justified();      // outputs justified
         } else if (search_limits_hit()) {
             break;                                  // decision or conflict limit
         } else if (circuit_restarting()) {
@@ -86,7 +201,7 @@ int Internal::circuit_cdcl_loop_with_inprocessing() {
             circuit_elim();                         // variable elimination
 #endif
         } else {
-            circuit_decide();                       // next decision
+            res = circuit_decide();                 // next decision
         }
     }
 
@@ -0,0 +1,299 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Persistent lemma cache for solving similar circuits (revisions of a design
+// or different outputs of the same netlist).  After solving, root-level
+// units, short learned gates and the empty clause are stored as nogoods over
+// structural hashes of the nodes (see 'Circuit_Graph::structural_hashes'),
+// which only depend on the fanin cones of the nodes.  A lemma was derived
+// from the gates and the asserted outputs of the old circuit, where gates
+// outside of the cones of the outputs and the lemma are just definitions of
+// fresh variables.  It is therefore implied in any circuit which contains
+// its nodes and asserts all outputs of its context, and only then imported.
+//
+// In particular the lemmas of one output carry over to all later revisions
+// in which the cone of this output did not change, and if that output was
+// shown to be unsatisfiable the empty clause is imported right away.
+//
+// Imported gates are redundant, thus they are subject to 'reduce' as any
+// other learned gate.  Since imported lemmas are not justified by a proof,
+// the cache is not loaded while tracing proofs.  Hash collisions of the
+// 64-bit structural hashes would be unsound but are negligible in practice.
+
+/*------------------------------------------------------------------------*/
+
+static const uint64_t circuit_lemmas_magic = 0x314d4d454c524943ull;  // "CIRLEMM1"
+
+static bool circuit_read_u64(FILE *file, uint64_t &res) {
+    return fread(&res, sizeof res, 1, file) == 1;
+}
+
+static bool circuit_read_hashes(FILE *file, std::vector<uint64_t> &res) {
+    uint64_t size;
+    if (!circuit_read_u64(file, size) || size > (1u << 24))
+        return false;
+    res.resize(size);
+    return !size || fread(res.data(), sizeof(uint64_t), size, file) == size;
+}
+
+static bool circuit_write_hashes(FILE *file, const std::vector<uint64_t> &hashes) {
+    const uint64_t size = hashes.size();
+    return fwrite(&size, sizeof size, 1, file) == 1 &&
+           (!size || fwrite(hashes.data(), sizeof(uint64_t), size, file) == size);
+}
+
+/**
+ * @brief:  Read the lemma cache in 'path' into 'lemmas'.
+ * @return  false if the file exists but is not a valid lemma cache
+ */
+static bool circuit_read_lemmas(const char *path, Circuit_Lemmas &lemmas) {
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return true;                    // no cache yet
+    bool res = false;
+    uint64_t magic, contexts, count;
+    if (circuit_read_u64(file, magic) && magic == circuit_lemmas_magic &&
+        circuit_read_u64(file, contexts) && contexts <= (1u << 24)) {
+        lemmas.contexts.resize(contexts);
+        res = true;
+        for (auto &context : lemmas.contexts)
+            if (!(res = circuit_read_hashes(file, context)))
+                break;
+        if (res && (res = circuit_read_u64(file, count) && count <= (1u << 30))) {
+            lemmas.lemmas.resize(count);
+            for (auto &lemma : lemmas.lemmas) {
+                uint64_t context;
+                if (!(res = circuit_read_u64(file, context) && context < contexts &&
+                            circuit_read_hashes(file, lemma.literals)))
+                    break;
+                lemma.context = context;
+            }
+        }
+    }
+    fclose(file);
+    if (!res)
+        lemmas = Circuit_Lemmas();
+    return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Load and store lemmas from and to 'path' (disabled for 0).
+ */
+void Internal::circuit_lemma_file(const char *path) {
+    circuit_lemma_path = path ? path : "";
+    circuit_lemmas_loaded = false;
+}
+
+/**
+ * @brief:  Sorted literal hashes of the outputs of the current circuit,
+ *          which are empty if outputs are not asserted (in server mode).
+ *          Lemmas learned under asserted outputs are thus not imported.
+ */
+std::vector<uint64_t> Internal::circuit_lemma_context(const std::vector<uint64_t> &hashes) const {
+    std::vector<uint64_t> res;
+    if (!opts.circuitoutputs)
+        return res;
+    for (const auto output : circuit_graph->get_outputs())
+        res.push_back(hashes[abs(output)] | (output < 0));
+    sort(res.begin(), res.end());
+    res.erase(unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+/**
+ * @brief:  Import the cached lemmas which are valid in this circuit.
+ */
+void Internal::circuit_load_lemmas() {
+    assert(!circuit_lemma_path.empty());
+    assert(!level);
+    circuit_lemmas_loaded = true;
+    if (!circuit_graph)
+        return;
+    if (!circuit_read_lemmas(circuit_lemma_path.c_str(), circuit_lemmas)) {
+        warning ("ignoring invalid lemma cache '%s'", circuit_lemma_path.c_str());
+        return;
+    }
+    if (proof) {
+        if (!circuit_lemmas.lemmas.empty())
+            warning ("not importing cached lemmas while tracing proofs");
+        return;
+    }
+    START (lemmas);
+
+    const std::vector<uint64_t> hashes = circuit_graph->structural_hashes();
+    std::unordered_map<uint64_t, int> nodes;
+    for (int idx = 1; idx < (int) hashes.size(); idx++)
+        if (hashes[idx])
+            nodes.emplace(hashes[idx], idx);
+    const std::vector<uint64_t> outputs = circuit_lemma_context(hashes);
+
+    std::vector<bool> valid;
+    for (const auto &context : circuit_lemmas.contexts)
+        valid.push_back(includes(outputs.begin(), outputs.end(),
+                                 context.begin(), context.end()));
+
+    // Units first (including the empty clause) and then gates, which are
+    // skipped if they contain root-level assigned literals.
+    //
+    for (int round = 0; !unsat && round < 2; round++) {
+        for (const auto &lemma : circuit_lemmas.lemmas) {
+            if (unsat)
+                break;
+            if (!valid[lemma.context])
+                continue;
+            if ((lemma.literals.size() > 1) != (round == 1))
+                continue;
+            assert(clause.empty());
+            bool skip = false;
+            for (const auto hash : lemma.literals) {
+                const auto it = nodes.find(hash & ~(uint64_t) 1);
+                if (it == nodes.end()) {
+                    skip = true;
+                    break;
+                }
+                const int lit = (hash & 1) ? -it->second : it->second;
+                const signed char tmp = val(lit);
+                if (tmp < 0 || marked(lit) < 0) {       // satisfied nogood
+                    skip = true;
+                    break;
+                }
+                if (tmp > 0 && round)                   // would need shrinking
+                    skip = true;
+                if (tmp > 0 || marked(lit) > 0)
+                    continue;
+                mark(lit);
+                clause.push_back(lit);
+            }
+            for (const auto lit : clause)
+                unmark(lit);
+            if (skip || (round && clause.size() < 2)) {
+                clause.clear();
+                continue;
+            }
+            stats.circuitlemmas.imported++;
+            if (clause.empty())
+                circuit_learn_empty_clause();
+            else if (clause.size() == 1) {
+                circuit_assign_unit(-clause[0]);
+                if (!circuit_propagate())
+                    circuit_learn_empty_clause();
+            } else {
+                Circuit_Gate *g = circuit_new_gate(true, clause.size());
+                circuit_watch_gate(g);
+            }
+            clause.clear();
+        }
+    }
+
+    PHASE ("lemmas", stats.circuitlemmas.imported,
+           "imported %" PRId64 " of %zd cached lemmas from '%s'",
+           stats.circuitlemmas.imported, circuit_lemmas.lemmas.size(),
+           circuit_lemma_path.c_str());
+    STOP (lemmas);
+}
+
+/**
+ * @brief:  Add the units, short learned gates and the empty clause of the
+ *          current circuit to the cache and write it.
+ */
+void Internal::circuit_save_lemmas() {
+    assert(!circuit_lemma_path.empty());
+    if (!circuit_graph)
+        return;
+    START (lemmas);
+
+    const std::vector<uint64_t> hashes = circuit_graph->structural_hashes();
+    const std::vector<uint64_t> outputs = circuit_lemma_context(hashes);
+    uint32_t context = 0;
+    while (context < circuit_lemmas.contexts.size() &&
+           circuit_lemmas.contexts[context] != outputs)
+        context++;
+    if (context == circuit_lemmas.contexts.size())
+        circuit_lemmas.contexts.push_back(outputs);
+
+    auto key = [](const Circuit_Lemma &lemma) {
+        uint64_t res = lemma.context;
+        for (const auto hash : lemma.literals)
+            res = (res ^ hash) * 0x100000001b3ull;
+        return res;
+    };
+    std::unordered_set<uint64_t> cached;
+    for (const auto &lemma : circuit_lemmas.lemmas)
+        cached.insert(key(lemma));
+
+    // Lemmas with literals which are not circuit nodes are skipped.
+    //
+    Circuit_Lemma lemma;
+    lemma.context = context;
+    auto add = [&](const int *begin, const int *end) {
+        lemma.literals.clear();
+        for (const int *p = begin; p != end; p++) {
+            const uint64_t hash = hashes[abs(*p)];
+            if (!hash)
+                return;
+            lemma.literals.push_back(hash | (*p < 0));
+        }
+        sort(lemma.literals.begin(), lemma.literals.end());
+        if (!cached.insert(key(lemma)).second)
+            return;
+        circuit_lemmas.lemmas.push_back(lemma);
+        stats.circuitlemmas.saved++;
+    };
+
+    if (unsat)
+        add(nullptr, nullptr);
+    for (auto idx : vars) {
+        const signed char tmp = val(idx);
+        if (!tmp || var(idx).level || idx >= (int) hashes.size())
+            continue;
+        const int nogood = tmp < 0 ? idx : -idx;
+        add(&nogood, &nogood + 1);
+    }
+    for (const auto &g : circuit_gates)
+        if (g->redundant && !g->garbage && g->size <= opts.circuitlemmasize)
+            add(g->begin(), g->end());
+
+    // Drop the oldest lemmas beyond the limit (unused contexts are kept).
+    //
+    const size_t max = opts.circuitlemmamax;
+    if (circuit_lemmas.lemmas.size() > max)
+        circuit_lemmas.lemmas.erase(circuit_lemmas.lemmas.begin(),
+                                    circuit_lemmas.lemmas.end() - max);
+
+    const std::string tmp = circuit_lemma_path + ".tmp";
+    FILE *file = fopen(tmp.c_str(), "wb");
+    bool ok = file;
+    if (ok) {
+        const uint64_t header[2] = {circuit_lemmas_magic, circuit_lemmas.contexts.size()};
+        ok = fwrite(header, sizeof header, 1, file) == 1;
+        for (const auto &c : circuit_lemmas.contexts)
+            ok = ok && circuit_write_hashes(file, c);
+        const uint64_t count = circuit_lemmas.lemmas.size();
+        ok = ok && fwrite(&count, sizeof count, 1, file) == 1;
+        for (const auto &l : circuit_lemmas.lemmas) {
+            const uint64_t c = l.context;
+            ok = ok && fwrite(&c, sizeof c, 1, file) == 1 &&
+                 circuit_write_hashes(file, l.literals);
+        }
+        if (fclose(file))
+            ok = false;
+        ok = ok && !rename(tmp.c_str(), circuit_lemma_path.c_str());
+    }
+    if (ok)
+        PHASE ("lemmas", stats.circuitlemmas.saved,
+               "saved %" PRId64 " new lemmas to '%s' (%zd cached)",
+               stats.circuitlemmas.saved, circuit_lemma_path.c_str(),
+               circuit_lemmas.lemmas.size());
+    else {
+        warning ("failed to write lemma cache '%s'", circuit_lemma_path.c_str());
+        remove(tmp.c_str());
+    }
+    STOP (lemmas);
+}
+
+} // namespace CaDiCaL
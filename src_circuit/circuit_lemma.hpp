@@ -0,0 +1,25 @@
+#ifndef _circuit_lemma_hpp_INCLUDED
+#define _circuit_lemma_hpp_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Contents of the persistent lemma cache (see 'circuit_lemma.cpp').  Lemmas
+// are nogoods over structural literal hashes and are only valid in circuits
+// which assert (at least) the outputs of their context.
+
+struct Circuit_Lemma {
+    uint32_t context;                   // index into 'contexts'
+    std::vector<uint64_t> literals;     // sorted literal hashes
+};
+
+struct Circuit_Lemmas {
+    std::vector<std::vector<uint64_t>> contexts;    // sorted output literal hashes
+    std::vector<Circuit_Lemma> lemmas;              // oldest first
+};
+
+} // namespace CaDiCaL
+
+#endif // _circuit_lemma_hpp_INCLUDED
@@ -0,0 +1,116 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Lucky phases for circuits by bit-parallel simulation.  Before the search
+// the AIG is simulated with 64 input patterns per round, starting with the
+// all-zero and all-one pattern and the saved phases of the inputs (which
+// reflect hints), followed by uniformly random and biased patterns (where
+// inputs are one with probability 1/8, 1/4, 3/4 or 7/8).  A pattern which
+// satisfies all outputs is a model and is checked by replaying it as
+// decisions.  Otherwise the pattern satisfying the most outputs seeds the
+// saved phases of all nodes, which are consistent with the gates, unless
+// saved phases were already set by hints, features or a checkpoint.  This
+// is only tried once and not again for incremental calls.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Simulate 'circuitlucky' rounds of input patterns and check
+ *          whether one of them satisfies the circuit.
+ * @return  10 if the circuit is satisfied and 0 otherwise
+ * @note:   lucky.cpp:  lucky_phases()
+ */
+int Internal::circuit_lucky_phases() {
+    assert(!level);
+    if (!opts.lucky || !opts.circuitlucky || !circuit_graph || unsat ||
+        !assumptions.empty() || circuit_lucky_tried)
+        return 0;
+    circuit_lucky_tried = true;
+    START (lucky);
+    stats.lucky.tried++;
+
+    const Circuit_Graph &graph = *circuit_graph;
+    const auto &inputs = graph.get_inputs();
+    const auto &outputs = graph.get_outputs();
+    const std::vector<int> order = graph.topological_order();
+    std::vector<uint64_t> values(graph.get_max_var() + 1, 0);
+    Random random(opts.seed);
+    random += stats.lucky.tried;
+
+    auto pattern = [&random](int round) {
+        const uint64_t a = random.next();
+        switch (round % 5) {
+        case 1: return a & random.next();
+        case 2: return a | random.next();
+        case 3: return a & random.next() & random.next();
+        case 4: return a | random.next() | random.next();
+        default: return a;
+        }
+    };
+
+    std::vector<signed char> best;
+    int best_score = -1;
+    int satisfied = -1;                 // lane of a satisfying pattern
+    int round = 0;
+    while (satisfied < 0 && round < opts.circuitlucky && !terminated_asynchronously()) {
+        for (const auto input : inputs) {
+            uint64_t v = pattern(round);
+            if (!round) {
+                v = (v & ~(uint64_t) 7) | 2;                  // zero, one
+                if (phases.saved[input] > 0)
+                    v |= 4;                                   // saved
+            }
+            values[input] = v;
+        }
+        graph.simulate(order, values);
+        round++;
+
+        uint64_t all = ~(uint64_t) 0;
+        int score[64] = {0};
+        for (const auto output : outputs) {
+            uint64_t v = values[abs(output)];
+            if (output < 0)
+                v = ~v;
+            all &= v;
+            for (int lane = 0; lane < 64; lane++)
+                score[lane] += (v >> lane) & 1;
+        }
+        int lane = 0;
+        if (all) {
+            while (!((all >> lane) & 1))
+                lane++;
+            satisfied = lane;
+        } else {
+            for (int i = 1; i < 64; i++)
+                if (score[i] > score[lane])
+                    lane = i;
+            if (score[lane] <= best_score)
+                continue;
+        }
+        best_score = score[lane];
+        best.resize(values.size());
+        for (size_t idx = 1; idx < values.size(); idx++)
+            best[idx] = ((values[idx] >> lane) & 1) ? 1 : -1;
+    }
+    stats.lucky.simulated += 64 * (int64_t) round;
+
+    int res = 0;
+    if (satisfied >= 0 || !circuit_phases_seeded)
+        circuit_seed_phases(best);
+    if (satisfied >= 0) {
+        res = circuit_try_to_satisfy_formula_by_saved_phases();
+        if (res == 10) {
+            stats.lucky.succeeded++;
+            stats.lucky.simulation++;
+        }
+    }
+    VERBOSE (2, "simulated %d lucky rounds with best pattern satisfying "
+             "%d of %zd outputs", round, best_score, outputs.size());
+    STOP (lucky);
+    return res;
+}
+
+} // namespace CaDiCaL
@@ -0,0 +1,93 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Memory accounting of the circuit engine.  The bytes of the gates are
+// updated whenever a gate is allocated, shrunken, deleted or changes from
+// redundant to irredundant, such that they are available in constant time
+// for 'report'.  The tables are linear in the number of variables and are
+// only summed up on request.
+
+/*------------------------------------------------------------------------*/
+
+template <class T>
+static size_t circuit_table_bytes(const vector<vector<T>> &table) {
+    size_t res = table.capacity() * sizeof(vector<T>);
+    for (const auto &v : table)
+        res += v.capacity() * sizeof(T);
+    return res;
+}
+
+/**
+ * @brief:  Update the gate byte counters by 'delta' bytes of 'g'.
+ */
+void Internal::circuit_account_gate(const Circuit_Gate *g, int64_t delta) {
+    int64_t &bytes = g->redundant ? circuit_learned_bytes : circuit_original_bytes;
+    bytes += delta;
+    assert(bytes >= 0);
+}
+
+Circuit_Memory Internal::circuit_memory() const {
+    Circuit_Memory res;
+    res.watches = circuit_table_bytes(circuit_wtab);
+    res.direct = circuit_table_bytes(circuit_dwtab);
+    res.original = circuit_original_bytes;
+    res.learned = circuit_learned_bytes;
+    res.occs = circuit_table_bytes(circuit_otab) + circuit_table_bytes(circuit_osigs);
+    res.bins = circuit_table_bytes(circuit_big);
+    res.arena = arena.bytes();
+    res.permanent = circuit_permanent.bytes();
+    return res;
+}
+
+/**
+ * @brief:  Bytes of a component by name ('total' for the sum).
+ * @return  -1 for unknown names
+ */
+int64_t Internal::circuit_memory(const char *name) const {
+    const Circuit_Memory m = circuit_memory();
+    if (!strcmp(name, "watches"))
+        return m.watches;
+    if (!strcmp(name, "direct"))
+        return m.direct;
+    if (!strcmp(name, "original"))
+        return m.original;
+    if (!strcmp(name, "learned"))
+        return m.learned;
+    if (!strcmp(name, "occs"))
+        return m.occs;
+    if (!strcmp(name, "bins"))
+        return m.bins;
+    if (!strcmp(name, "arena"))
+        return m.arena;
+    if (!strcmp(name, "permanent"))
+        return m.permanent;
+    if (!strcmp(name, "total"))
+        return m.total();
+    return -1;
+}
+
+void Internal::circuit_print_memory() {
+#ifndef QUIET
+    const Circuit_Memory m = circuit_memory();
+    const size_t total = m.total();
+    auto line = [&](const char *name, size_t bytes) {
+        MSG ("%-10s %15zd bytes %10.2f MB %8.2f %%", name, bytes,
+             bytes / (double) (1l << 20), percent (bytes, total));
+    };
+    SECTION ("circuit memory");
+    line ("watches:", m.watches);
+    line ("direct:", m.direct);
+    line ("original:", m.original);
+    line ("learned:", m.learned);
+    line ("occs:", m.occs);
+    line ("bins:", m.bins);
+    line ("total:", total);
+    line ("arena:", m.arena);
+    line ("permanent:", m.permanent);
+#endif
+}
+
+} // namespace CaDiCaL
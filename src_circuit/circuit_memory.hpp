@@ -0,0 +1,30 @@
+#ifndef _circuit_memory_hpp_INCLUDED
+#define _circuit_memory_hpp_INCLUDED
+
+#include <cstddef>
+
+namespace CaDiCaL {
+
+// Bytes used by the data structures of the circuit engine (see
+// 'circuit_memory.cpp').  Gate bytes are maintained incrementally, the
+// tables are summed up over their vectors when requested.  The arena spaces
+// hold gates and are thus not part of 'total'.
+
+struct Circuit_Memory {
+    size_t watches = 0;                 // 'circuit_wtab'
+    size_t direct = 0;                  // 'circuit_dwtab'
+    size_t original = 0;                // irredundant gates
+    size_t learned = 0;                 // redundant gates
+    size_t occs = 0;                    // 'circuit_otab' and 'circuit_osigs'
+    size_t bins = 0;                    // 'circuit_big'
+    size_t arena = 0;                   // 'from' and 'to' space of 'arena'
+    size_t permanent = 0;               // region of original gates
+
+    size_t total() const {
+        return watches + direct + original + learned + occs + bins;
+    }
+};
+
+} // namespace CaDiCaL
+
+#endif // _circuit_memory_hpp_INCLUDED
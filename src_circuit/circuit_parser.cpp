@@ -2,7 +2,7 @@
 
 namespace CaDiCaL {
 
-const char* Circuit_Parser::parse_aag(const char* path, int& vars) {
+const char* Circuit_Parser::read_aag(const char* path, int& vars, Circuit_Graph*& graph) {
     std::ifstream file(path);
     if (!file.good())
         return internal->error_message.init ("failed to read aag file '%s'", path);
@@ -10,71 +10,294 @@ const char* Circuit_Parser::parse_aag(const char* path, int& vars) {
     START (parse);
     int line_ctr = 0;
     int inputs_num = 0;
+    int latches_num = 0;
     int outputs_num = 0;
+    int bad_num = 0;
+    int constraints_num = 0;
     int num = 0;
     int and_num = 0;
+    bool false_output = false;
 
+    // Sections after the 'M I L O A [B C J F]' header line: inputs, latches,
+    // outputs, bad state properties, invariant constraints and AND gates,
+    // followed by the (ignored) symbol table and comments.
+    //
     Circuit_Graph* graph_ptr = nullptr;
     for (std::string line; std::getline(file, line, '\n');)  {
         ++line_ctr;
-        if(line.find("aag") != std::string::npos) {
+        if(line_ctr == 1 && line.find("aag") != std::string::npos) {
             std::vector<std::string> temp = m_split(line, " ");
             and_num = std::stoi(temp[5]);
-            if (and_num == 0) {
-                internal->unsat = true;
+            latches_num = std::stoi(temp[3]);
+            if (temp.size() > 6)
+                bad_num = std::stoi(temp[6]);
+            if (temp.size() > 7)
+                constraints_num = std::stoi(temp[7]);
+            if ((temp.size() > 8 && std::stoi(temp[8])) ||
+                (temp.size() > 9 && std::stoi(temp[9]))) {
                 STOP (parse);
-                return 0;
+                return internal->error_message.init (
+                    "justice and fairness properties in '%s' are not supported", path);
             }
             num = std::stoi(temp[1]);
             vars = num;
-            solver->reserve(vars);
 
             inputs_num = std::stoi(temp[2]);
             outputs_num = std::stoi(temp[4]);
             
-            graph_ptr = new Circuit_Graph(inputs_num, outputs_num, and_num);
+            graph_ptr = new Circuit_Graph(num, inputs_num, outputs_num, and_num);
             continue;
         }
+        if (!graph_ptr)
+            break;
 
-        if(line_ctr > 1 && line_ctr <= inputs_num + 1) {
+        int pos = line_ctr - 2;
+        if(pos < inputs_num) {
             graph_ptr->add_input(std::stoi(line));
             continue;
         }
-    
-        if(line_ctr > inputs_num + 1 && line_ctr <= inputs_num + outputs_num + 1) {
-            graph_ptr->add_output(std::stoi(line));
+        pos -= inputs_num;
+        if (pos < latches_num) {
+            std::vector<std::string> latch = m_split(line, " ");
+            const int lit = std::stoi(latch[0]);
+            const int next = std::stoi(latch[1]);
+            const int reset = latch.size() > 2 ? std::stoi(latch[2]) : 0;
+            if (next < 2) {
+                delete graph_ptr;
+                STOP (parse);
+                return internal->error_message.init (
+                    "constant next state of latch %d in '%s' is not supported", lit, path);
+            }
+            graph_ptr->add_latch(lit, next, reset);
+            continue;
+        }
+        pos -= latches_num;
+        if(pos < outputs_num) {
+            // Constant outputs of combinational AIGs are trivially true
+            // (and skipped) or make the circuit inconsistent.
+            //
+            const int output = std::stoi(line);
+            if (output < 2 && !latches_num && !constraints_num && !bad_num) {
+                false_output |= !output;
+                continue;
+            }
+            const bool bad = !bad_num && (latches_num || constraints_num);
+            if (output < 2 && bad) {
+                delete graph_ptr;
+                STOP (parse);
+                return internal->error_message.init (
+                    "constant output %d in '%s' is not supported", output, path);
+            }
+            graph_ptr->add_output(output);
+            if (bad)
+                graph_ptr->add_bad(output);
             continue;
         }
-        if(line_ctr <= num + outputs_num + 1) {
+        pos -= outputs_num;
+        if (pos < bad_num + constraints_num) {
+            const int lit = std::stoi(line);
+            if (lit < 2) {
+                delete graph_ptr;
+                STOP (parse);
+                return internal->error_message.init (
+                    "constant %s %d in '%s' is not supported",
+                    pos < bad_num ? "bad state" : "constraint", lit, path);
+            }
+            if (pos < bad_num)
+                graph_ptr->add_bad(lit);
+            else
+                graph_ptr->add_constraint(lit);
+            continue;
+        }
+        pos -= bad_num + constraints_num;
+        if(pos < and_num) {
             std::vector<std::string> gate = m_split(line, " ");
             int output = std::stoi(gate[0]);
             int input1 = std::stoi(gate[1]);
             int input2 = std::stoi(gate[2]);
             graph_ptr->add_and_gate(output, {input1, input2});
-
-            auto mark_flag_func = [this](int id) {
-                Flags &f = internal->flags (id);
-                if (f.status == Flags::UNUSED)
-                    internal->mark_active (id);
-                else if (f.status != Flags::ACTIVE && f.status != Flags::FIXED)
-                    internal->reactivate (id);
-            };
-            mark_flag_func(input1 / 2);
-            mark_flag_func(input2 / 2);
-            mark_flag_func(output / 2);
-
             continue;
         }
+        break;
+    }
+
+    if (!graph_ptr) {
+        STOP (parse);
+        return internal->error_message.init ("missing 'aag' header in '%s'", path);
+    }
+
+    // Without gates and variables the circuit is trivially satisfiable
+    // and thus treated as an empty formula (with zero graph).
+    //
+    if (false_output || !num) {
+        delete graph_ptr;
+        if (false_output)
+            internal->unsat = true;
+        STOP (parse);
+        return 0;
     }
 
     assert (graph_ptr->get_num_gates() == and_num &&
             graph_ptr->get_num_inputs() == inputs_num &&
-            graph_ptr->get_num_gates() == and_num);
+            graph_ptr->get_num_latches() == latches_num);
+
+    graph = graph_ptr;
+    STOP (parse);
+    return 0;
+}
+
+const char* Circuit_Parser::parse_aag(const char* path, int& vars, const char* cnf_path) {
+    Circuit_Graph* graph_ptr = nullptr;
+    const char* err = read_aag(path, vars, graph_ptr);
+    if (err)
+        return err;
+    // Inconsistent and empty (trivially satisfiable) circuits are solved as
+    // formula without gates by the selected engine (CaDiCaL if automatic).
+    //
+    if (!graph_ptr) {
+        if (!internal->opts.satsolvermode)
+            internal->opts.satsolvermode = 3;
+        if (internal->opts.satsolvermode == 2)
+            encode_into_easysat(nullptr);
+        return 0;
+    }
+
+    // Sequential AIGs are unrolled by the circuit engine frame by frame
+    // during 'solve' (see 'circuit_bmc.cpp'), which thus is enforced.
+    //
+    if (graph_ptr->is_sequential()) {
+        if (cnf_path || internal->opts.satsolvermode > 1) {
+            delete graph_ptr;
+            return internal->error_message.init (
+                "sequential AIG '%s' requires the circuit engine "
+                "(without '-a')", path);
+        }
+        if (!internal->opts.satsolvermode) {
+            MSG ("selecting circuit engine for sequential AIG");
+            internal->opts.satsolvermode = 1;
+        }
+        solver->reserve(vars);
+        internal->circuit_graph = graph_ptr;
+        return 0;
+    }
+
+    // The engine has to be selected before reserving variables, since the
+    // circuit specific tables are only allocated in the circuit mode.
+    //
+    Circuit_Features features;
+    if (!internal->opts.satsolvermode) {
+        features = internal->circuit_compute_features(*graph_ptr);
+        internal->circuit_select_engine(features);
+    }
+    solver->reserve(vars);
+
+    if (cnf_path && (err = write_cnf(*graph_ptr, cnf_path))) {
+        delete graph_ptr;
+        return err;
+    }
+
+    if (internal->opts.satsolvermode == 1) {
+        // Rewriting replaces the graph, while proofs refer to the original
+        // gates.  New nodes get variables beyond 'vars'.  Removed nodes are
+        // unconstrained, thus without asserted outputs (where assumptions
+        // may refer to any node) the graph is kept.
+        //
+        if (internal->opts.circuitrewrite && internal->opts.circuitoutputs &&
+            !internal->proof) {
+            Circuit_Graph *rewritten = internal->circuit_rewrite(*graph_ptr);
+            if (rewritten) {
+                delete graph_ptr;
+                graph_ptr = rewritten;
+                solver->reserve(graph_ptr->get_max_var());
+            }
+        }
+
+        // The graph stays alive as read-only gate database for the circuit
+        // specific procedures (cube generation for instance) and is owned by
+        // 'internal' from here on.
+        //
+        internal->circuit_graph = graph_ptr;
+        internal->circuit_init(graph_ptr);
+        if (!features.witness.empty())
+            internal->circuit_seed_phases(features.witness);
+        return 0;
+    }
 
-    internal->circuit_init(graph_ptr);
+    if (internal->opts.satsolvermode == 2)
+        encode_into_easysat(graph_ptr);
+    else
+        encode_into_solver(*graph_ptr);
     delete graph_ptr;
+    return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Feeding the CNF encoding of the circuit directly to the CNF engines avoids
+// writing and parsing an intermediate DIMACS file.
 
+void Circuit_Parser::encode_into_solver(const Circuit_Graph& graph) {
+    START (parse);
+    const bool pg = internal->opts.circuitcnf == 2;
+    const size_t clauses = graph.encode_cnf(pg, [this](const std::vector<int>& clause) {
+        for (const auto lit : clause)
+            solver->add(lit);
+        solver->add(0);
+    });
+    MSG ("encoded %d AND gates into %zd clauses", graph.get_num_gates(), clauses);
+    STOP (parse);
+}
+
+void Circuit_Parser::encode_into_easysat(const Circuit_Graph* graph) {
+    EasySAT_Solver* easysat = new EasySAT_Solver();
+    easysat->internal = internal;
+    internal->easysat_solver = easysat;
+    if (internal->unsat) {
+        easysat->parse_res = 20;
+        return;
+    }
+
+    START (parse);
+    easysat->vars = graph ? graph->get_max_var() : 0;
+    easysat->clauses = 0;
+    easysat->alloc_memory();
+    int res = 0;
+    const bool pg = internal->opts.circuitcnf == 2;
+    if (graph)
+        easysat->clauses = graph->encode_cnf(pg, [easysat, &res](const std::vector<int>& clause) {
+            if (res)
+                return;
+            std::vector<int> tmp(clause);
+            res = easysat->add_original(tmp);
+        });
+    easysat->parse_res = res ? res : easysat->finish_original();
     STOP (parse);
+}
+
+// The encoding is traversed twice, first to count the clauses for the
+// header and then to stream them to the file, without storing the CNF.
+
+const char* Circuit_Parser::write_cnf(const Circuit_Graph& graph, const char* path) {
+    File* file = File::write(internal, path);
+    if (!file)
+        return internal->error_message.init ("failed to open DIMACS file '%s' for writing", path);
+
+    const bool pg = internal->opts.circuitcnf == 2;
+    const size_t clauses = graph.encode_cnf(pg, [](const std::vector<int>&) {});
+    MSG ("writing %s'p cnf %d %zd'%s header", tout.green_code (),
+         graph.get_max_var(), clauses, tout.normal_code ());
+
+    bool ok = file->put ("p cnf ") && file->put (graph.get_max_var()) &&
+              file->put (' ') && file->put ((int64_t) clauses) && file->put ('\n');
+    graph.encode_cnf(pg, [file, &ok](const std::vector<int>& clause) {
+        for (const auto lit : clause)
+            ok = ok && file->put (lit) && file->put (' ');
+        ok = ok && file->put ("0\n");
+    });
+    delete file;
+
+    if (!ok)
+        return internal->error_message.init ("writing to DIMACS file '%s' failed", path);
     return 0;
 }
 
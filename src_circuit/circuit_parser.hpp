@@ -8,6 +8,7 @@
 namespace CaDiCaL {
 
 struct Internal;
+class Circuit_Graph;
 
 class Circuit_Parser {
     Solver* solver;
@@ -16,7 +17,15 @@ class Circuit_Parser {
 public:
     Circuit_Parser(Solver* s) : solver(s), internal(s->internal) {}
 
-    const char* parse_aag(const char* path, int& vars);
+    // Depending on 'satsolvermode' the circuit is either used by the circuit
+    // engine or its CNF encoding is fed to EasySAT or the CNF engine.  If
+    // 'cnf_path' is given the CNF encoding is also written to that file.
+    const char* parse_aag(const char* path, int& vars, const char* cnf_path = nullptr);
+
+    const char* read_aag(const char* path, int& vars, Circuit_Graph*& graph);
+    const char* write_cnf(const Circuit_Graph& graph, const char* path);
+    void encode_into_solver(const Circuit_Graph& graph);
+    void encode_into_easysat(const Circuit_Graph* graph);
 
     std::vector<std::string> m_split(const std::string& input, const std::string& pred);
 };
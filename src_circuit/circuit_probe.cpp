@@ -117,6 +117,8 @@ inline int Internal::circuit_hyper_binary_resolve (Circuit_Gate *reason) {
         assert(clause.empty());
         clause.push_back (dom);
         clause.push_back (lits[0]);
+        if (lrat)
+            circuit_build_chain_for_conflict (reason, {0, 0});
         Circuit_Gate *c = circuit_new_hyper_binary_resolved_clause(red, 2);
         circuit_probe_reason = c;
         if (red)
@@ -146,6 +148,8 @@ inline void Internal::circuit_probe_assign(int lit, int parent) {
     v.trail = (int) trail.size();
     assert ((int) num_assigned < max_var);
     num_assigned++;
+    if (!level)
+        circuit_probe_lrat_for_units (lit);
     v.circuit_reason = level ? circuit_probe_reason : nullptr;
     v.circuit_reason_direct = level ? circuit_probe_reason_direct : 0;
     circuit_probe_reason = nullptr, circuit_probe_reason_direct = 0;
@@ -200,9 +204,16 @@ void Internal::circuit_probe_assign_unit (int lit) {
  * @note:   probe.cpp:  probe_lrat_for_units()
  */
 inline void Internal::circuit_probe_lrat_for_units (int lit) {
-    // TODO(taomengxia: 2025/02/20): maybe need to implement.
-    (void)lit;
-    return;
+    if (!lrat)
+        return;
+    if (level)
+        return;
+    if (!lrat_chain.empty ())
+        return;   // failed literal chain
+    if (!circuit_probe_reason && !circuit_probe_reason_direct)
+        return;
+    LOG ("building chain for probe unit %d", lit);
+    circuit_build_chain_for_units (lit, circuit_probe_reason, circuit_probe_reason_direct);
 }
 
 
@@ -412,10 +423,20 @@ void Internal::circuit_failed_literal (int failed) {
     LOG ("found probing UIP %d", uip);
     assert (uip);
 
+    if (lrat) {
+        assert (clause.empty ());
+        clause.push_back (uip);
+        circuit_build_chain_for_conflict (circuit_conflict_gate, circuit_conflict_direct);
+        clause.clear ();
+    }
+
+    // The failed parents of the UIP would need their own chains, which are
+    // not available after backtracking, thus they are skipped for LRAT.
+    //
     vector<int> work;
 
     int parent = uip;
-    while (parent != failed) {
+    while (!lrat && parent != failed) {
         const int next = circuit_get_parent_reason_literal (parent);
         parent = next;
         assert (parent);
@@ -563,6 +584,24 @@ void Internal::circuit_generate_probes() {
     rsort(probes.begin(), probes.end(), circuit_probe_noccs_rank (this));
 
     reset_noccs();
+
+    // Both phases of reconvergence points, their stems and high-fanout
+    // nodes are probed first, the ones with the largest fanout first.
+    //
+    if (opts.circuitprobestruct) {
+        circuit_analyze_structure();
+        for (const auto idx : circuit_structural_nodes) {
+            if (!active(idx))
+                continue;
+            for (const auto probe : {idx, -idx}) {
+                if (propfixed (probe) >= stats.all.fixed)
+                    continue;
+                LOG ("scheduling structural probe %d", probe);
+                probes.push_back (probe);
+            }
+        }
+    }
+
     shrink_vector(probes);
 
     PHASE ("probe-round", stats.probingrounds,
@@ -579,6 +618,15 @@ void Internal::circuit_flush_probes () {
 
     assert (!probes.empty());
 
+    // Structural probes do not need binary occurrences, thus the schedule
+    // is generated again (filtered by 'propfixed' as well).
+    //
+    if (opts.circuitprobestruct) {
+        probes.clear ();
+        circuit_generate_probes ();
+        return;
+    }
+
     init_noccs();
     circuit_calculate_noccs_in_binary();
 
@@ -711,7 +759,12 @@ bool Internal::circuit_probe_round () {
 
     int probe;
     circuit_init_probehbr_lrat();
-    while (!unsat && !terminated_asynchronously () &&
+    // Without LRAT chains the probes are independent and can be propagated
+    // in parallel (see 'circuit_probe_parallel.cpp').
+    //
+    if (!lrat && circuit_probe_threads() > 1)
+        circuit_probe_parallel(limit);
+    else while (!unsat && !terminated_asynchronously () &&
             stats.propagations.probe < limit && (probe = circuit_next_probe ())) {
         stats.probed++;
         LOG ("probing %d", probe);
@@ -793,6 +846,8 @@ void Internal::circuit_probe (bool update_limits) {
         if (!circuit_probe_round ())
         break;
 
+    circuit_recursive_learning ();
+
     circuit_decompose (); // ... and (ELS) afterwards.    
 
     last.probe.propagations = stats.propagations.search;
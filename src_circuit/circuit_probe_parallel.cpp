@@ -0,0 +1,302 @@
+#include "../src/internal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Parallel root-level failed literal probing.  All probes of a round are
+// independent at decision level zero, thus they are distributed over
+// worker threads, which propagate over a shared read-only snapshot of the
+// gates (occurrence lists instead of watches, since watches are moved by
+// propagation) and the direct implication table with private values,
+// trail and parents.  Workers record failed literals (the dominator of the
+// conflict, i.e., the UIP) and hyper binary resolvents per probe.
+//
+// The main thread merges the results in schedule order.  Workers take
+// the probes of a batch through an atomic counter, and batches are started
+// until the propagations of the probed prefix of the schedule exceed the
+// budget.  Since the result of each probe only depends on the snapshot and
+// the merge stops at the first probe exceeding the budget, the outcome is
+// independent of the number of threads and of their scheduling (unless
+// probing is terminated).
+
+/*------------------------------------------------------------------------*/
+
+namespace {
+
+struct Circuit_Probe_Result {
+    bool done = false;
+    int failed = 0;                             // UIP of a failed probe
+    int64_t propagations = 0;
+    std::vector<std::pair<int, int>> hbrs;      // binary gates '{dom, lit}'
+};
+
+struct Circuit_Probe_Snapshot {
+    int max_var;
+    bool hbr;
+    std::vector<signed char> root;              // root values per variable
+    std::vector<size_t> offsets;                // occurrence lists per literal
+    std::vector<const Circuit_Gate *> occs;
+    const std::vector<std::vector<int>> *direct;
+
+    static unsigned vlit(int lit) { return (lit < 0) + 2u * (unsigned) abs(lit); }
+};
+
+class Circuit_Probe_Worker {
+    const Circuit_Probe_Snapshot &snapshot;
+    std::vector<signed char> vals;
+    std::vector<int> parents, positions;
+    std::vector<int> trail;
+
+    signed char val(int lit) const {
+        const signed char res = vals[abs(lit)];
+        return lit < 0 ? -res : res;
+    }
+
+    bool root(int lit) const { return snapshot.root[abs(lit)] != 0; }
+
+    void assign(int lit, int parent) {
+        const int idx = abs(lit);
+        assert(!vals[idx]);
+        vals[idx] = lit < 0 ? -1 : 1;
+        parents[idx] = parent;
+        positions[idx] = trail.size();
+        trail.push_back(lit);
+    }
+
+    // Same as 'circuit_probe_dominator' on the private trail.
+    //
+    int dominator(int a, int b) const {
+        while (a != b) {
+            if (positions[abs(a)] < positions[abs(b)])
+                swap(a, b);
+            a = parents[abs(a)];
+        }
+        return a;
+    }
+
+public:
+    Circuit_Probe_Worker(const Circuit_Probe_Snapshot &s)
+        : snapshot(s), vals(s.root), parents(s.max_var + 1, 0),
+          positions(s.max_var + 1, 0) {}
+
+    void probe(int probe, Circuit_Probe_Result &res) {
+        assign(probe, 0);
+        int conflict = 0;
+        for (size_t next = 0; !conflict && next < trail.size(); next++) {
+            const int lit = trail[next];
+
+            for (const auto direct : (*snapshot.direct)[Circuit_Probe_Snapshot::vlit(lit)]) {
+                const signed char tmp = val(direct);
+                if (tmp > 0)
+                    continue;
+                if (tmp < 0) {
+                    conflict = root(direct) ? lit : dominator(lit, -direct);
+                    break;
+                }
+                assign(direct, lit);
+            }
+
+            const size_t begin = snapshot.offsets[Circuit_Probe_Snapshot::vlit(lit)];
+            const size_t end = snapshot.offsets[Circuit_Probe_Snapshot::vlit(lit) + 1];
+            for (size_t i = begin; !conflict && i < end; i++) {
+                const Circuit_Gate *g = snapshot.occs[i];
+                int unassigned = 0, dom = 0, non_root = 0;
+                bool done = false;
+                for (const auto &other : *g) {
+                    const signed char tmp = val(other);
+                    if (tmp < 0 || (!tmp && unassigned)) {
+                        done = true;
+                        break;
+                    }
+                    if (!tmp)
+                        unassigned = other;
+                    else if (!root(other)) {
+                        dom = dom ? dominator(dom, other) : other;
+                        non_root++;
+                    }
+                }
+                if (done)
+                    continue;
+                if (!unassigned) {
+                    conflict = dom;
+                    break;
+                }
+                if (non_root > 1 && snapshot.hbr)
+                    res.hbrs.push_back({dom, unassigned});
+                assign(-unassigned, dom);
+            }
+        }
+
+        res.failed = conflict;
+        res.propagations = trail.size();
+        res.done = true;
+
+        for (const auto lit : trail)
+            vals[abs(lit)] = 0;
+        trail.clear();
+    }
+};
+
+} // namespace
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Number of probing threads, where 1 means sequential probing.
+ */
+unsigned Internal::circuit_probe_threads() {
+    unsigned res = opts.circuitprobethreads;
+    if (!res)
+        res = std::thread::hardware_concurrency();
+    if (!res)
+        res = 1;
+    return res;
+}
+
+/**
+ * @brief:  Probe all scheduled literals in parallel within the given limit
+ *          of probing propagations and merge the results.
+ * @note:   Only used without LRAT, since workers do not record chains.
+ */
+void Internal::circuit_probe_parallel(int64_t limit) {
+    require_mode (PROBE);
+    assert(!level);
+    assert(!lrat);
+    assert(propagated == trail.size());
+
+    std::vector<int> schedule;
+    for (int probe; (probe = circuit_next_probe ()); ) {
+        if (propfixed (probe) >= stats.all.fixed)
+            continue;
+        propfixed (probe) = stats.all.fixed;    // avoids duplicates
+        schedule.push_back(probe);
+    }
+    if (schedule.empty())
+        return;
+
+    Circuit_Probe_Snapshot snapshot;
+    snapshot.max_var = max_var;
+    snapshot.hbr = opts.probehbr;
+    snapshot.direct = &circuit_dwtab;
+    snapshot.root.assign(max_var + 1, 0);
+    for (auto idx : vars)
+        snapshot.root[idx] = val(idx);
+
+    // Occurrence lists of the non-garbage gates, which are neither
+    // satisfied nor contain two root-level false literals.
+    //
+    std::vector<size_t> counts(2 * (max_var + 1) + 1, 0);
+    std::vector<const Circuit_Gate *> gates;
+    for (const auto &g : circuit_gates) {
+        if (g->garbage)
+            continue;
+        bool satisfied = false;
+        for (const auto &lit : *g)
+            if ((satisfied = val(lit) < 0))
+                break;
+        if (satisfied)
+            continue;
+        gates.push_back(g);
+        for (const auto &lit : *g)
+            counts[Circuit_Probe_Snapshot::vlit(lit) + 1]++;
+    }
+    snapshot.offsets.assign(counts.size(), 0);
+    for (size_t i = 1; i < counts.size(); i++)
+        snapshot.offsets[i] = snapshot.offsets[i - 1] + counts[i];
+    snapshot.occs.resize(snapshot.offsets.back());
+    std::vector<size_t> fill(snapshot.offsets.begin(), snapshot.offsets.end() - 1);
+    for (const auto g : gates)
+        for (const auto &lit : *g)
+            snapshot.occs[fill[Circuit_Probe_Snapshot::vlit(lit)]++] = g;
+
+    // Probes are distributed in batches, where the next batch is only
+    // started if the probes so far stay within the budget.  Only the main
+    // thread polls for termination (the terminator is not thread-safe) and
+    // tells the workers through 'terminated'.
+    //
+    const int64_t budget = limit - stats.propagations.probe;
+    std::vector<Circuit_Probe_Result> results(schedule.size());
+    std::atomic<bool> terminated(false);
+    std::atomic<size_t> next(0);
+    std::atomic<unsigned> finished(0);
+    size_t end = 0;
+
+    auto work = [&]() {
+        Circuit_Probe_Worker worker(snapshot);
+        for (size_t i; !terminated && (i = next++) < end;)
+            worker.probe(schedule[i], results[i]);
+        finished++;
+    };
+
+    unsigned threads = circuit_probe_threads();
+    if (threads > schedule.size())
+        threads = schedule.size();
+    const size_t batch = 64 * (size_t) threads;
+    int64_t used = 0;
+    while (end < schedule.size() && used < budget && !terminated) {
+        const size_t begin = end;
+        end = std::min(schedule.size(), end + batch);
+        next = begin;
+        finished = 0;
+        std::vector<std::thread> pool;
+        for (unsigned i = 0; i < threads; i++)
+            pool.emplace_back(work);
+        while (finished < threads) {
+            if (!terminated && terminated_asynchronously())
+                terminated = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        for (auto &thread : pool)
+            thread.join();
+        for (size_t i = begin; i < end && results[i].done; i++)
+            used += results[i].propagations;
+    }
+
+    // Merge in schedule order up to the (deterministic) budget.
+    //
+    int64_t merged = 0;
+    size_t probed = 0;
+    for (size_t i = 0; !unsat && i < schedule.size() && merged < budget; i++) {
+        const Circuit_Probe_Result &res = results[i];
+        if (!res.done)
+            break;
+        merged += res.propagations;
+        stats.propagations.probe += res.propagations;
+        stats.probed++;
+        probed++;
+
+        for (const auto &hbr : res.hbrs) {
+            if (val(hbr.first) || val(hbr.second))
+                continue;
+            stats.hbrs++;
+            stats.hbreds++;
+            assert(clause.empty());
+            clause.push_back(hbr.first);
+            clause.push_back(hbr.second);
+            Circuit_Gate *c = circuit_new_hyper_binary_resolved_clause(true, 2);
+            c->hyper = true;
+            clause.clear();
+        }
+
+        const int uip = res.failed;
+        if (!uip || val(uip))
+            continue;
+        LOG ("parallel probing found failed literal %d with UIP %d", schedule[i], uip);
+        stats.failed++;
+        stats.probefailed++;
+        circuit_probe_assign_unit(-uip);
+        if (!circuit_probe_propagate())
+            circuit_learn_empty_clause();
+    }
+
+    PHASE ("probe-round", stats.probingrounds,
+           "merged %zd of %zd probes from %u threads",
+           probed, schedule.size(), threads);
+}
+
+} // namespace CaDiCaL
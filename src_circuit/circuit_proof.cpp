@@ -0,0 +1,243 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Proof tracing for the circuit engine.  The implicit original formula is
+// the Tseitin encoding of the AIG.  For each AND gate 'out = a & b' in the
+// order of the AIG file the clauses
+//
+//   (-a -b out)  (-out a)  (-out b)
+//
+// get consecutive ids, followed by one unit clause for each output.  A gate
+// with literals 'l_1, ..., l_n' (which must not all be true) is traced as
+// the clause '-l_1 ... -l_n'.  The binary clauses are not stored as gates
+// but only used through the direct implication table 'circuit_dwtab',
+// which is why their ids are kept separately in 'circuit_direct_ids'.
+
+/*------------------------------------------------------------------------*/
+
+static inline uint64_t circuit_direct_key(unsigned a, unsigned b) {
+    if (a > b)
+        swap(a, b);
+    return ((uint64_t) a << 32) | b;
+}
+
+static inline void circuit_gate_to_clause(const Circuit_Gate *g, vector<int> &res) {
+    assert(res.empty());
+    for (const auto &lit : *g)
+        res.push_back(-lit);
+}
+
+/**
+ * @brief:  Trace the Tseitin clauses of an original AND gate.
+ */
+void Internal::circuit_proof_add_original_gate(Circuit_Gate *g) {
+    assert(proof);
+    assert(!g->redundant);
+    assert(g->size == 2 || g->size == 3);
+
+    vector<int> lits;
+    circuit_gate_to_clause(g, lits);
+    proof->add_original_clause(g->id, false, lits);
+
+    // Same literals as used in 'circuit_watch_gate_direct', where gates
+    // with identical inputs (equivalences) are binary.
+    //
+    const int output = g->literals[g->size - 1];
+    for (int i = 0; i < 2; i++) {
+        const int input = g->literals[i ? g->size - 2 : 0];
+        const uint64_t id = ++clause_id;
+        lits = {output, input};
+        proof->add_original_clause(id, false, lits);
+        if (lrat)
+            circuit_direct_ids.emplace(circuit_direct_key(vlit(output), vlit(input)), id);
+    }
+}
+
+/**
+ * @brief:  Trace a learned gate with the current 'lrat_chain'.
+ * @note:   clause.cpp: new_learned_redundant_clause()
+ */
+void Internal::circuit_proof_add_derived_gate(Circuit_Gate *g) {
+    assert(proof);
+    vector<int> lits;
+    circuit_gate_to_clause(g, lits);
+    proof->add_derived_clause(g->id, g->redundant, lits, lrat_chain);
+}
+
+/**
+ * @note:   clause.cpp: mark_garbage() and delete_clause()
+ */
+void Internal::circuit_proof_delete_gate(Circuit_Gate *g) {
+    assert(proof);
+    vector<int> lits;
+    circuit_gate_to_clause(g, lits);
+    proof->delete_clause(g->id, g->redundant, lits);
+}
+
+/**
+ * @brief:  Trace removing root-level true literals from a gate, before the
+ *          literals are actually removed.  The gate gets a new id.
+ * @note:   proof.cpp:  flush_clause()
+ */
+void Internal::circuit_proof_flush_gate(Circuit_Gate *g) {
+    assert(proof);
+    assert(lrat_chain.empty());
+    vector<int> lits;
+    for (const auto &lit : *g) {
+        if (fixed(lit) > 0) {
+            if (lrat)
+                lrat_chain.push_back(unit_clauses[vlit(lit)]);
+        } else
+            lits.push_back(-lit);
+    }
+    lrat_chain.push_back(g->id);
+    const uint64_t new_id = ++clause_id;
+    proof->add_derived_clause(new_id, g->redundant, lits, lrat_chain);
+    lrat_chain.clear();
+    circuit_proof_delete_gate(g);
+    g->id = new_id;
+}
+
+/**
+ * @brief:  Trace removing 'lit' from the gate with the chain given in
+ *          'lrat_chain', before the literal is actually removed.
+ * @note:   proof.cpp:  strengthen_clause()
+ */
+void Internal::circuit_proof_strengthen_gate(Circuit_Gate *g, int lit) {
+    assert(proof);
+    vector<int> lits;
+    for (const auto &other : *g)
+        if (other != lit)
+            lits.push_back(-other);
+    const uint64_t new_id = ++clause_id;
+    proof->add_derived_clause(new_id, g->redundant, lits, lrat_chain);
+    lrat_chain.clear();
+    circuit_proof_delete_gate(g);
+    g->id = new_id;
+}
+
+/**
+ * @brief:  Id of the binary clause '-lit direct' behind 'direct' being
+ *          in the direct watches of 'lit'.
+ */
+uint64_t Internal::circuit_direct_id(int lit, int direct) {
+    assert(lrat);
+    const auto it = circuit_direct_ids.find(circuit_direct_key(vlit(-lit), vlit(direct)));
+    assert(it != circuit_direct_ids.end());
+    return it->second;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Chain for a root-level unit 'lit' forced by the given reason.
+ * @note:   propagate.cpp:  build_chain_for_units()
+ */
+void Internal::circuit_build_chain_for_units(int lit, Circuit_Gate *reason, int reason_direct) {
+    if (!lrat)
+        return;
+    assert(lrat_chain.empty());
+    if (reason) {
+        for (const auto &other : *reason) {
+            if (other == -lit)
+                continue;
+            assert(val(other) > 0);
+            lrat_chain.push_back(unit_clauses[vlit(other)]);
+        }
+        lrat_chain.push_back(reason->id);
+    } else {
+        assert(reason_direct);
+        assert(val(reason_direct) > 0);
+        lrat_chain.push_back(unit_clauses[vlit(reason_direct)]);
+        lrat_chain.push_back(circuit_direct_id(reason_direct, lit));
+    }
+}
+
+/**
+ * @brief:  Chain for the gate in 'clause' (empty for the empty clause)
+ *          derived from a conflict, i.e., a gate (or direct implication)
+ *          whose literals are all true or in 'clause'.
+ *
+ * Instead of recording antecedents in each of the analysis, minimization
+ * and shrinking procedures, the trail is walked backwards once, starting
+ * at the conflict and following reasons of the literals the conflict
+ * depends on.  The walk stops at the literals of 'clause' and root-level
+ * literals, which contribute their unit ids.  Thus it only visits the part
+ * of the trail above the lowest needed literal.
+ *
+ * @note:   analyze.cpp:    analyze() with 'lrat'
+ */
+void Internal::circuit_build_chain_for_conflict(Circuit_Gate *conflict,
+                                                const std::array<int, 2> &conflict_direct) {
+    if (!lrat)
+        return;
+    assert(lrat_chain.empty());
+    assert(conflict || conflict_direct[0]);
+
+    const int assumed_bit = 0, needed_bit = 1;
+    for (const auto &lit : clause)
+        setbit(lit, assumed_bit);
+
+    vector<int> needed;
+    vector<uint64_t> reasons;
+    size_t pending = 0;
+
+    auto need = [&](int lit) {
+        if (getbit(lit, assumed_bit) || getbit(lit, needed_bit))
+            return;
+        assert(val(lit) > 0);
+        setbit(lit, needed_bit);
+        needed.push_back(lit);
+        if (var(lit).level)
+            pending++;
+        else
+            lrat_chain.push_back(unit_clauses[vlit(lit)]);
+    };
+
+    uint64_t conflict_id;
+    if (conflict) {
+        for (const auto &lit : *conflict)
+            need(lit);
+        conflict_id = conflict->id;
+    } else {
+        need(conflict_direct[0]);
+        need(conflict_direct[1]);
+        conflict_id = circuit_direct_id(conflict_direct[0], -conflict_direct[1]);
+    }
+
+    for (size_t i = trail.size(); pending && i; ) {
+        const int lit = trail[--i];
+        if (!getbit(lit, needed_bit))
+            continue;
+        const Var &v = var(lit);
+        if (!v.level)
+            continue;
+        pending--;
+        if (v.circuit_reason) {
+            reasons.push_back(v.circuit_reason->id);
+            for (const auto &other : *v.circuit_reason)
+                if (other != -lit)
+                    need(other);
+        } else {
+            // Decisions have to be in 'clause'.
+            //
+            assert(v.circuit_reason_direct);
+            reasons.push_back(circuit_direct_id(v.circuit_reason_direct, lit));
+            need(v.circuit_reason_direct);
+        }
+    }
+    assert(!pending);
+
+    lrat_chain.insert(lrat_chain.end(), reasons.rbegin(), reasons.rend());
+    lrat_chain.push_back(conflict_id);
+
+    for (const auto &lit : needed)
+        unsetbit(lit, needed_bit);
+    for (const auto &lit : clause)
+        unsetbit(lit, assumed_bit);
+}
+
+}  // namespace CaDiCaL
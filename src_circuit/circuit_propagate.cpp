@@ -2,6 +2,16 @@
 
 namespace CaDiCaL {
 
+// Hot path counters are compiled in with '-DCIRCUITSTATS' only.
+//
+#ifdef CIRCUITSTATS
+#define CIRCUIT_PROP_STAT(NAME, DELTA) \
+    (stats.circuitprop[stable].NAME += (DELTA))
+#else
+#define CIRCUIT_PROP_STAT(NAME, DELTA) \
+    do { } while (0)
+#endif
+
 static Circuit_Gate circuit_decision_reason_gate;
 static Circuit_Gate *circuit_decision_reason = &circuit_decision_reason_gate;
 
@@ -43,8 +53,11 @@ inline void Internal::circuit_search_assign(int lit, Circuit_Gate* reason, int r
         lit_level = reason ? circuit_assignment_level(lit, reason) : circuit_assign_level_get(reason_direct);
     else
         lit_level = level;
-    if (!lit_level)
+    if (!lit_level) {
+        if (lrat && lrat_chain.empty () && (reason || reason_direct))
+            circuit_build_chain_for_units (lit, reason, reason_direct);
         reason = nullptr, reason_direct = 0;
+    }
 
     v.level = lit_level;
     v.trail = (int) trail.size();
@@ -104,19 +117,82 @@ void Internal::circuit_search_assign_driving(int lit, Circuit_Gate *reason, int
     circuit_search_assign(lit, reason, reason_direct);
 }
 
+/**
+ * @brief:  Assign the saved implied literals following the saved literal
+ *          at 'circuit_saved_pos', which was just propagated (see 'circuit_trail.cpp').
+ */
+void Internal::circuit_replay_trail() {
+    const auto &saved = circuit_saved_trail;
+    assert(circuit_saved_pos < saved.size());
+    assert(val(saved[circuit_saved_pos].lit) > 0);
+
+    size_t pos = circuit_saved_pos + 1;
+    while (pos < saved.size()) {
+        const Circuit_Saved_Literal &s = saved[pos];
+        if (!s.reason && !s.reason_direct)
+            break;                      // wait for the decision
+        const signed char tmp = val(s.lit);
+        if (tmp > 0) {
+            pos++;
+            continue;
+        }
+        bool valid = !tmp;
+        if (valid && s.reason) {
+            const Circuit_Gate *g = s.reason;
+            bool found = false;
+            valid = !g->garbage;
+            for (int i = 0; valid && i < g->size; i++) {
+                const int other = g->literals[i];
+                if (other == -s.lit)
+                    found = true;
+                else if (val(other) <= 0)
+                    valid = false;
+            }
+            valid = valid && found;
+        } else if (valid)
+            valid = val(s.reason_direct) > 0;
+        if (!valid) {
+            LOG ("saved trail invalid at %d", s.lit);
+            circuit_clear_saved_trail();
+            return;
+        }
+        circuit_search_assign(s.lit, s.reason, s.reason_direct);
+        stats.circuittrail.replayed++;
+        pos++;
+    }
+    circuit_saved_pos = pos;
+}
+
 /**
  * @return      true: propagate success; false: generate conflict
  */
 bool Internal::circuit_propagate() {
     START (propagate);
     
+    // Watches of gates satisfied by a literal assigned at a lower non-root
+    // level than 'lit' are suspended until that literal is unassigned.
+    //
+    const bool lazy = opts.circuitlazy;
+
     int64_t before = propagated;
     while (!circuit_conflict_gate && !circuit_conflict_direct[0] &&
             propagated != trail.size()) {
         const int lit = trail[propagated++];
+        const int lit_level = var(lit).level;
+        if (circuit_saved_pos < circuit_saved_trail.size() &&
+            circuit_saved_trail[circuit_saved_pos].lit == lit)
+            circuit_replay_trail();
+        auto suspend = [&](int blit, const Circuit_Watch &w) {
+            const int blit_level = var(blit).level;
+            if (!blit_level || blit_level >= lit_level)
+                return false;
+            circuit_suspend_watch(blit_level, lit, w);
+            return true;
+        };
 
         // 1. Propagate direct
         const auto &dws = circuit_direct_watches(lit);
+        CIRCUIT_PROP_STAT(directs, dws.size());
         for (const auto &direct : dws) {
             circuit_propagate_direct(lit, direct);
         }
@@ -132,9 +208,14 @@ bool Internal::circuit_propagate() {
 
             const Circuit_Watch w = *j++ = *i++;
             const signed char b = circuit_val(w.blit);
+            CIRCUIT_PROP_STAT(watches, 1);
 
-            if (b < 0)
+            if (b < 0) {
+                CIRCUIT_PROP_STAT(blits, 1);
+                if (lazy && !w.binary() && suspend(w.blit, w))
+                    j--;
                 continue;       // blocking literal is unwatch-value
+            }
 
             if (w.binary()) {
                 if (b > 0) {    // blocking literal was assigned with watch-value: generate conflict
@@ -156,8 +237,12 @@ bool Internal::circuit_propagate() {
                 const int other = lits[0] ^ lits[1] ^ lit;
                 const signed char u = circuit_val(other);
                 if (u < 0) {    // Other was assigned with unwatch-value, no need to analyze. Can not generate assign or conflict.
+                    CIRCUIT_PROP_STAT(others, 1);
                     j[-1].blit = other;
+                    if (lazy && suspend(other, j[-1]))
+                        j--;
                 } else {
+                    CIRCUIT_PROP_STAT(searches, 1);
                     const int size = w.gate->size;
                     const circuit_literal_iterator middle = lits + w.gate->pos;
                     const circuit_const_literal_iterator end = lits + size;
@@ -170,12 +255,14 @@ bool Internal::circuit_propagate() {
 
                     while (k != end && (v = circuit_val(r = *k)) > 0)
                         k++;
+                    CIRCUIT_PROP_STAT(scans, k - middle);
 
                     if (v > 0) { // need second search starting at the head?
                         k = lits + 2;
                         assert(w.gate->pos <= size);
                         while (k != middle && (v = circuit_val(r = *k)) > 0)
                             k++;
+                        CIRCUIT_PROP_STAT(scans, k - (lits + 2));
                     }
 
                     w.gate->pos = (k - lits); // always save position
@@ -183,6 +270,8 @@ bool Internal::circuit_propagate() {
 
                     if (v < 0) {        // Replacement is assigned with unwatch-value, so just replace blit.
                         j[-1].blit = r;
+                        if (lazy && suspend(r, j[-1]))
+                            j--;
                     } else if (!v) {    // Found new unassigend replacement literal to be watched.
 
                         lits[0] = other;
@@ -213,9 +302,14 @@ bool Internal::circuit_propagate() {
     }
 
     stats.propagations.search += (propagated - before);
+    CIRCUIT_PROP_STAT(props, propagated - before);
     if (!circuit_conflict_gate && !circuit_conflict_direct[0]) {
         no_conflict_until = propagated;
     } else {
+        if (circuit_conflict_gate)
+            CIRCUIT_PROP_STAT(gateconfs, 1);
+        else
+            CIRCUIT_PROP_STAT(dirconfs, 1);
         if (stable)
             stats.stabconflicts++;
         stats.conflicts++;
@@ -9,7 +9,8 @@ namespace CaDiCaL {
 bool Internal::circuit_restarting() {
     if (!opts.restart)
         return false;
-    /// TODO(taomengxia): cadical use assumptions
+    if (level < (int) assumptions.size() + 2)
+        return false;
     if (stabilizing())
         return reluctant;
     if (stats.conflicts <= lim.restart)
@@ -33,13 +34,18 @@ void Internal::circuit_restart() {
     if (stable)
         stats.restartstable++;
     LOG ("restart %" PRId64 "", stats.restarts);
-    circuit_backtrack(reuse_trail());
+    const int new_level = reuse_trail();
+    circuit_save_trail(new_level, level);
+    circuit_backtrack(new_level);
 
     lim.restart = stats.conflicts + opts.restartint;
     LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
 
     report ('R', 2);
     STOP (restart);
+
+    if (circuit_checkpointing())
+        circuit_checkpoint();
 }
 
 }
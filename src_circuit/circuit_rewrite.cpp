@@ -0,0 +1,631 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// DAG-aware rewriting of combinational AIGs before 'circuit_init'.  For
+// each AND node (in topological order) 4-input cuts are enumerated together
+// with their truth tables.  The function of a cut is classified by its NPN
+// class (permutation and negation of the inputs and negation of the output)
+// and replaced by the optimal subgraph of the class from a built-in library
+// if the nodes added (after structural hashing with the existing nodes) are
+// fewer than the nodes of the maximum fanout-free cone of the node which
+// become unused.  Nodes outside of the cones of the outputs are dropped.
+//
+// The library is enumerated exhaustively once, i.e., it contains minimum
+// size (and among those minimum depth) subgraphs of up to four AND nodes
+// for all functions with four inputs which have one.  Replaced nodes keep
+// their variables and their original definitions are pushed on the
+// extension stack to complete models, while new nodes get fresh variables.
+
+/*------------------------------------------------------------------------*/
+
+// Literals of library subgraphs are '2 * i' for input 'i' (0..3) and
+// '2 * (4 + j)' for node 'j', where the lowest bit negates.
+
+static const int circuit_subgraph_max = 4;
+
+struct Circuit_Subgraph {
+    signed char size = -1;      // number of nodes (-1 if none is known)
+    signed char depth = 0;
+    unsigned char out = 0;      // output literal
+    unsigned char fanins[circuit_subgraph_max][2];
+};
+
+// Transformation of a truth table, where the result has the value of 'f'
+// at the input 'i' replaced by input 'perm[i]' negated if bit 'i' of 'neg'
+// is set, and negated if 'out' is set.
+//
+struct Circuit_NPN {
+    unsigned char perm[4];
+    unsigned char neg;
+    bool out;
+};
+
+struct Circuit_Rewrite_Library {
+    std::vector<Circuit_Subgraph> subgraphs;    // one per NPN class
+    std::vector<uint16_t> npn_class;            // per truth table (0 if none)
+    std::vector<uint16_t> npn_transform;        // from class to truth table
+    std::vector<Circuit_NPN> transforms;
+};
+
+static const uint16_t circuit_var_truth[4] = {0xaaaa, 0xcccc, 0xf0f0, 0xff00};
+
+static uint16_t circuit_npn_apply(const Circuit_NPN &t, uint16_t f) {
+    uint16_t res = 0;
+    for (unsigned m = 0; m < 16; m++) {
+        unsigned y = 0;
+        for (unsigned i = 0; i < 4; i++)
+            y |= (((m >> t.perm[i]) ^ (t.neg >> i)) & 1) << i;
+        if ((f >> y) & 1)
+            res |= 1u << m;
+    }
+    return t.out ? ~res : res;
+}
+
+// Depth-first enumeration of chains of AND nodes, where each node computes
+// a new function (different from the inputs and earlier nodes), and two
+// consecutive independent nodes are ordered to avoid enumerating both
+// orders.
+//
+static void circuit_enumerate_subgraphs(std::vector<Circuit_Subgraph> &best,
+                                        Circuit_Subgraph &chain,
+                                        uint16_t *truth, signed char *depth,
+                                        int size) {
+    const int nodes = 4 + size;
+    const int last = size ? (chain.fanins[size - 1][0] << 8 | chain.fanins[size - 1][1]) : -1;
+    for (int a = 0; a < nodes; a++)
+        for (int b = a + 1; b < nodes; b++)
+            for (int polarity = 0; polarity < 4; polarity++) {
+                const int la = 2 * a + (polarity & 1), lb = 2 * b + (polarity >> 1);
+                if (size && b != nodes - 1 && (la << 8 | lb) <= last)
+                    continue;
+                const uint16_t t = (polarity & 1 ? ~truth[a] : truth[a]) &
+                                   (polarity & 2 ? ~truth[b] : truth[b]);
+                if (!t)
+                    continue;
+                bool fresh = true;
+                for (int i = 0; fresh && i < nodes; i++)
+                    fresh = t != truth[i] && t != (uint16_t) ~truth[i];
+                if (!fresh)
+                    continue;
+                chain.fanins[size][0] = la;
+                chain.fanins[size][1] = lb;
+                truth[nodes] = t;
+                depth[nodes] = 1 + std::max(depth[a], depth[b]);
+                for (int sign = 0; sign < 2; sign++) {
+                    Circuit_Subgraph &s = best[sign ? (uint16_t) ~t : t];
+                    if (s.size >= 0 && (s.size < size + 1 ||
+                        (s.size == size + 1 && s.depth <= depth[nodes])))
+                        continue;
+                    s = chain;
+                    s.size = size + 1;
+                    s.depth = depth[nodes];
+                    s.out = 2 * nodes + sign;
+                }
+                if (size + 1 < circuit_subgraph_max)
+                    circuit_enumerate_subgraphs(best, chain, truth, depth, size + 1);
+            }
+}
+
+static Circuit_Rewrite_Library circuit_build_rewrite_library() {
+    Circuit_Rewrite_Library res;
+    std::vector<Circuit_Subgraph> best(1 << 16);
+    for (int i = 0; i < 4; i++)
+        for (int sign = 0; sign < 2; sign++) {
+            Circuit_Subgraph &s = best[sign ? (uint16_t) ~circuit_var_truth[i] : circuit_var_truth[i]];
+            s.size = 0;
+            s.out = 2 * i + sign;
+        }
+    Circuit_Subgraph chain;
+    uint16_t truth[4 + circuit_subgraph_max];
+    signed char depth[4 + circuit_subgraph_max] = {0};
+    for (int i = 0; i < 4; i++)
+        truth[i] = circuit_var_truth[i];
+    circuit_enumerate_subgraphs(best, chain, truth, depth, 0);
+
+    unsigned char perm[4] = {0, 1, 2, 3};
+    do {
+        for (unsigned neg = 0; neg < 16; neg++)
+            for (int out = 0; out < 2; out++) {
+                Circuit_NPN t;
+                std::copy(perm, perm + 4, t.perm);
+                t.neg = neg, t.out = out;
+                res.transforms.push_back(t);
+            }
+    } while (std::next_permutation(perm, perm + 4));
+
+    // The first function of each NPN class (by size) represents the class
+    // and all functions of the class are mapped to it.  Since negations
+    // are for free all functions of a class have the same minimum size.
+    //
+    res.npn_class.assign(1 << 16, 0);
+    res.npn_transform.assign(1 << 16, 0);
+    res.subgraphs.push_back(Circuit_Subgraph());
+    for (int size = 0; size <= circuit_subgraph_max; size++)
+        for (unsigned f = 0; f < (1u << 16); f++) {
+            if (best[f].size != size || res.npn_class[f])
+                continue;
+            const uint16_t npn_class = res.subgraphs.size();
+            res.subgraphs.push_back(best[f]);
+            for (size_t i = 0; i < res.transforms.size(); i++) {
+                const uint16_t g = circuit_npn_apply(res.transforms[i], f);
+                if (res.npn_class[g])
+                    continue;
+                res.npn_class[g] = npn_class;
+                res.npn_transform[g] = i;
+            }
+        }
+    return res;
+}
+
+static const Circuit_Rewrite_Library &circuit_rewrite_library() {
+    static const Circuit_Rewrite_Library library = circuit_build_rewrite_library();
+    return library;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Cuts are sorted sets of at most four node ids with the truth table of
+// the node in terms of the leaves, where leaf 'i' is input 'i'.
+
+struct Circuit_Cut {
+    int size;
+    uint16_t truth;
+    int leaves[4];
+};
+
+static const size_t circuit_max_cuts = 8;
+
+// Truth table of 'cut' in terms of the leaves of 'merged' (a superset).
+//
+static uint16_t circuit_expand_truth(const Circuit_Cut &cut, const Circuit_Cut &merged) {
+    int pos[4];
+    for (int i = 0, j = 0; i < cut.size; i++) {
+        while (merged.leaves[j] != cut.leaves[i])
+            j++;
+        pos[i] = j;
+    }
+    uint16_t res = 0;
+    for (unsigned m = 0; m < 16; m++) {
+        unsigned y = 0;
+        for (int i = 0; i < cut.size; i++)
+            y |= ((m >> pos[i]) & 1) << i;
+        if ((cut.truth >> y) & 1)
+            res |= 1u << m;
+    }
+    return res;
+}
+
+static bool circuit_merge_cuts(const Circuit_Cut &a, const Circuit_Cut &b, Circuit_Cut &res) {
+    int i = 0, j = 0, k = 0;
+    while (i < a.size || j < b.size) {
+        int leaf;
+        if (j == b.size || (i < a.size && a.leaves[i] < b.leaves[j]))
+            leaf = a.leaves[i++];
+        else if (i == a.size || b.leaves[j] < a.leaves[i])
+            leaf = b.leaves[j++];
+        else
+            leaf = a.leaves[i++], j++;
+        if (k == 4)
+            return false;
+        res.leaves[k++] = leaf;
+    }
+    res.size = k;
+    return true;
+}
+
+static bool circuit_cut_subsumes(const Circuit_Cut &a, const Circuit_Cut &b) {
+    return std::includes(b.leaves, b.leaves + b.size, a.leaves, a.leaves + a.size);
+}
+
+/*------------------------------------------------------------------------*/
+
+// The AIG during rewriting, where node ids of the original graph are kept
+// and new nodes are appended.  Replaced nodes point to the replacing
+// literal in 'repr' and are removed, while fanins are only updated lazily.
+
+struct Circuit_Rewriter {
+    const Circuit_Rewrite_Library &library;
+    std::vector<std::array<int, 2>> fanins;     // zero for inputs
+    std::vector<int> refs;                      // references by nodes and outputs
+    std::vector<int> repr;
+    std::vector<bool> removed;
+    std::vector<std::vector<Circuit_Cut>> cuts;
+    std::unordered_map<uint64_t, int> strash;
+    std::vector<int> outputs;
+    int64_t evaluated = 0, rewritten = 0;
+
+    Circuit_Rewriter() : library(circuit_rewrite_library()) {}
+
+    bool is_and(int idx) const { return fanins[idx][0]; }
+
+    int find(int lit) const {
+        int idx = abs(lit);
+        while (repr[idx]) {
+            const int r = repr[idx];
+            lit = lit < 0 ? -r : r;
+            idx = abs(r);
+        }
+        return lit;
+    }
+
+    int fanin(int idx, int i) { return fanins[idx][i] = find(fanins[idx][i]); }
+
+    static uint64_t key(int a, int b) {
+        if (a > b)
+            std::swap(a, b);
+        return (uint64_t) (uint32_t) a << 32 | (uint32_t) b;
+    }
+
+    int lookup(int a, int b) const {
+        const auto it = strash.find(key(a, b));
+        return it == strash.end() || removed[it->second] ? 0 : it->second;
+    }
+
+    int new_node(int a, int b);
+    void compute_cuts(int idx);
+    int deref(int idx);
+    void ref(int idx);
+    int evaluate(int idx, const Circuit_Cut &cut);
+    int instantiate(const Circuit_Cut &cut);
+    void replace(int idx, int lit);
+    void rewrite(int idx);
+    std::vector<int> topological_order();
+};
+
+int Circuit_Rewriter::new_node(int a, int b) {
+    a = find(a), b = find(b);
+    if (a == b)
+        return a;
+    if (const int idx = lookup(a, b))
+        return idx;
+    const int idx = fanins.size();
+    fanins.push_back({a, b});
+    refs.push_back(0);
+    repr.push_back(0);
+    removed.push_back(false);
+    cuts.emplace_back();
+    refs[abs(a)]++, refs[abs(b)]++;
+    strash[key(a, b)] = idx;
+    compute_cuts(idx);
+    return idx;
+}
+
+void Circuit_Rewriter::compute_cuts(int idx) {
+    auto &res = cuts[idx];
+    res.clear();
+    Circuit_Cut trivial{1, circuit_var_truth[0], {idx, 0, 0, 0}};
+    res.push_back(trivial);
+    if (!is_and(idx))
+        return;
+    const int a = fanin(idx, 0), b = fanin(idx, 1);
+    const auto &as = cuts[abs(a)], &bs = cuts[abs(b)];
+    std::vector<Circuit_Cut> candidates;
+    for (const auto &ca : as)
+        for (const auto &cb : bs) {
+            Circuit_Cut c;
+            if (!circuit_merge_cuts(ca, cb, c))
+                continue;
+            bool valid = true;
+            for (int i = 0; valid && i < c.size; i++)
+                valid = !removed[c.leaves[i]];
+            if (!valid)
+                continue;
+            const uint16_t ta = circuit_expand_truth(ca, c);
+            const uint16_t tb = circuit_expand_truth(cb, c);
+            c.truth = (a < 0 ? ~ta : ta) & (b < 0 ? ~tb : tb);
+            candidates.push_back(c);
+        }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Circuit_Cut &x, const Circuit_Cut &y) { return x.size < y.size; });
+    for (const auto &c : candidates) {
+        if (res.size() > circuit_max_cuts)
+            break;
+        bool subsumed = false;
+        for (size_t i = 1; !subsumed && i < res.size(); i++)
+            subsumed = circuit_cut_subsumes(res[i], c);
+        if (!subsumed)
+            res.push_back(c);
+    }
+}
+
+// Dereference the cone of 'idx' (with protected leaves) and return the
+// number of nodes which become unused, i.e., the size of its maximum
+// fanout-free cone, and reference them again.
+//
+int Circuit_Rewriter::deref(int idx) {
+    int res = 1;
+    for (int i = 0; i < 2; i++) {
+        const int child = abs(fanin(idx, i));
+        if (!--refs[child] && is_and(child))
+            res += deref(child);
+    }
+    return res;
+}
+
+void Circuit_Rewriter::ref(int idx) {
+    for (int i = 0; i < 2; i++) {
+        const int child = abs(fanins[idx][i]);
+        if (!refs[child]++ && is_and(child))
+            ref(child);
+    }
+}
+
+// Number of nodes which would be added for the library subgraph of 'cut'
+// (or 'INT_MAX' if not applicable) while its cone is dereferenced.
+//
+int Circuit_Rewriter::evaluate(int idx, const Circuit_Cut &cut) {
+    const uint16_t npn_class = library.npn_class[cut.truth];
+    if (!npn_class)
+        return INT_MAX;
+    const Circuit_Subgraph &s = library.subgraphs[npn_class];
+    const Circuit_NPN &t = library.transforms[library.npn_transform[cut.truth]];
+
+    // Inputs of the subgraph beyond the leaves of the cut are irrelevant
+    // for its function, but are not expected to be used either.
+    //
+    auto missing = [&](int l) { return l < 8 && t.perm[l / 2] >= cut.size; };
+    if (missing(s.out))
+        return INT_MAX;
+    for (int j = 0; j < s.size; j++)
+        if (missing(s.fanins[j][0]) || missing(s.fanins[j][1]))
+            return INT_MAX;
+
+    int lits[4 + circuit_subgraph_max];     // zero if not existing yet
+    for (int i = 0; i < 4; i++) {
+        const int j = t.perm[i];
+        lits[i] = j < cut.size ? ((t.neg >> i) & 1 ? -cut.leaves[j] : cut.leaves[j]) : 0;
+    }
+    auto literal = [&lits](int l) { return l & 1 ? -lits[l / 2] : lits[l / 2]; };
+    int res = 0;
+    for (int j = 0; j < s.size; j++) {
+        const int a = literal(s.fanins[j][0]), b = literal(s.fanins[j][1]);
+        int lit = 0;
+        if (!a || !b)
+            res++;
+        else if (a == b)
+            lit = a;
+        else if (a == -b)
+            return INT_MAX;
+        else if ((lit = lookup(a, b))) {
+            if (lit == idx)
+                return INT_MAX;
+            if (!refs[lit])
+                res++;          // in the cone of 'idx' but kept
+        } else
+            res++;
+        lits[4 + j] = lit;
+    }
+    if (abs(literal(s.out)) == idx)
+        return INT_MAX;
+    return res;
+}
+
+int Circuit_Rewriter::instantiate(const Circuit_Cut &cut) {
+    const uint16_t npn_class = library.npn_class[cut.truth];
+    const Circuit_Subgraph &s = library.subgraphs[npn_class];
+    const Circuit_NPN &t = library.transforms[library.npn_transform[cut.truth]];
+    int lits[4 + circuit_subgraph_max];
+    for (int i = 0; i < 4; i++) {
+        const int j = t.perm[i];
+        lits[i] = j < cut.size ? ((t.neg >> i) & 1 ? -cut.leaves[j] : cut.leaves[j]) : 0;
+    }
+    auto literal = [&lits](int l) { return l & 1 ? -lits[l / 2] : lits[l / 2]; };
+    for (int j = 0; j < s.size; j++)
+        lits[4 + j] = new_node(literal(s.fanins[j][0]), literal(s.fanins[j][1]));
+    const int out = literal(s.out);
+    return t.out ? -out : out;
+}
+
+// Replace 'idx' by 'lit' and remove the nodes which became unused.
+//
+void Circuit_Rewriter::replace(int idx, int lit) {
+    assert(abs(lit) != idx);
+    repr[idx] = lit;
+    refs[abs(lit)] += refs[idx];
+    refs[idx] = 0;
+    std::vector<int> stack = {idx};
+    while (!stack.empty()) {
+        const int node = stack.back();
+        stack.pop_back();
+        assert(!removed[node]);
+        removed[node] = true;
+        const auto it = strash.find(key(fanins[node][0], fanins[node][1]));
+        if (it != strash.end() && it->second == node)
+            strash.erase(it);
+        for (int i = 0; i < 2; i++) {
+            const int child = abs(fanin(node, i));
+            if (!--refs[child] && is_and(child) && !removed[child])
+                stack.push_back(child);
+        }
+    }
+}
+
+void Circuit_Rewriter::rewrite(int idx) {
+    // Normalize the fanins and merge with a structurally identical node.
+    //
+    const int a = fanin(idx, 0), b = fanin(idx, 1);
+    const auto it = strash.find(key(a, b));
+    if (it != strash.end() && it->second != idx && !removed[it->second]) {
+        replace(idx, it->second);
+        return;
+    }
+    strash[key(a, b)] = idx;
+    compute_cuts(idx);
+
+    const Circuit_Cut *best = nullptr;
+    int best_gain = 0;
+    for (size_t i = 1; i < cuts[idx].size(); i++) {
+        const Circuit_Cut &cut = cuts[idx][i];
+        evaluated++;
+        for (int j = 0; j < cut.size; j++)
+            refs[cut.leaves[j]]++;
+        const int mffc = deref(idx);
+        const int added = evaluate(idx, cut);
+        ref(idx);
+        for (int j = 0; j < cut.size; j++)
+            refs[cut.leaves[j]]--;
+        if (added == INT_MAX || mffc - added <= best_gain)
+            continue;
+        best_gain = mffc - added;
+        best = &cut;
+    }
+    if (!best)
+        return;
+    const Circuit_Cut cut = *best;      // 'cuts' might be reallocated
+    const int lit = instantiate(cut);
+    replace(idx, lit);
+    rewritten++;
+}
+
+// Nodes in the cones of the outputs with fanins before fanouts.
+//
+std::vector<int> Circuit_Rewriter::topological_order() {
+    std::vector<int> res, stack;
+    std::vector<signed char> state(fanins.size(), 0);
+    for (auto &output : outputs) {
+        output = find(output);
+        stack.push_back(abs(output));
+        while (!stack.empty()) {
+            const int idx = stack.back();
+            if (state[idx] == 2 || !is_and(idx)) {
+                stack.pop_back();
+                continue;
+            }
+            if (!state[idx]) {
+                state[idx] = 1;
+                for (int i = 0; i < 2; i++) {
+                    const int child = abs(fanin(idx, i));
+                    if (!state[child])
+                        stack.push_back(child);
+                }
+                continue;
+            }
+            stack.pop_back();
+            state[idx] = 2;
+            res.push_back(idx);
+        }
+    }
+    return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Rewrite the combinational AIG 'graph' in 'circuitrewrite' rounds
+ *          and push the definitions of removed nodes on the extension stack.
+ * @return  the rewritten graph or zero if nothing changed
+ */
+Circuit_Graph *Internal::circuit_rewrite(const Circuit_Graph &graph) {
+    assert(!graph.is_sequential());
+    START (rewrite);
+
+    Circuit_Rewriter rewriter;
+    const int max_node = graph.get_max_var();
+    rewriter.fanins.assign(max_node + 1, {0, 0});
+    rewriter.refs.assign(max_node + 1, 0);
+    rewriter.repr.assign(max_node + 1, 0);
+    rewriter.removed.assign(max_node + 1, false);
+    rewriter.cuts.resize(max_node + 1);
+    for (const auto gate : graph.get_gates()) {
+        const auto &inputs = gate->get_PIs();
+        assert(inputs.size() == 2);
+        rewriter.fanins[gate->get_PO()] = {inputs[0], inputs[1]};
+    }
+    rewriter.outputs = graph.get_outputs();
+    for (const auto output : rewriter.outputs)
+        rewriter.refs[abs(output)]++;
+
+    // Nodes outside of the cones of the outputs are removed first.
+    //
+    std::vector<int> order = rewriter.topological_order();
+    std::vector<bool> used(max_node + 1, false);
+    for (const auto idx : order)
+        used[idx] = true;
+    for (const auto idx : order)
+        for (int i = 0; i < 2; i++)
+            rewriter.refs[abs(rewriter.fanins[idx][i])]++;
+    for (int idx = 1; idx <= max_node; idx++)
+        if (!rewriter.is_and(idx))
+            rewriter.compute_cuts(idx);
+        else if (!used[idx])
+            rewriter.removed[idx] = true;
+
+    const int64_t limit = opts.circuitrewritelim;
+    int round = 0;
+    while (round < opts.circuitrewrite && rewriter.evaluated < limit) {
+        const int64_t before = rewriter.rewritten;
+        rewriter.strash.clear();
+        for (const auto idx : order) {
+            if (rewriter.evaluated >= limit)
+                break;
+            if (!rewriter.removed[idx])
+                rewriter.rewrite(idx);
+        }
+        order = rewriter.topological_order();
+        round++;
+        if (rewriter.rewritten == before)
+            break;
+    }
+    stats.circuitrewrite.rounds += round;
+    stats.circuitrewrite.rewritten += rewriter.rewritten;
+
+    Circuit_Graph *res = nullptr;
+    if ((int) order.size() < graph.get_num_gates() || rewriter.rewritten) {
+        auto aiger = [](int lit) { return 2 * abs(lit) + (lit < 0); };
+        const int max_var = rewriter.fanins.size() - 1;
+        res = new Circuit_Graph(max_var, graph.get_num_inputs(),
+                                graph.get_num_outputs(), order.size());
+        for (const auto input : graph.get_inputs())
+            res->add_input(2 * input);
+        for (const auto output : rewriter.outputs)
+            res->add_output(aiger(output));
+        std::vector<bool> kept(max_var + 1, false);
+        for (const auto idx : order) {
+            const auto &f = rewriter.fanins[idx];
+            res->add_and_gate(2 * idx, {aiger(f[0]), aiger(f[1])});
+            kept[idx] = true;
+        }
+
+        // The original definitions of removed nodes extend models, where
+        // the extension stack is traversed backward, thus fanins last and
+        // the gate clause before the binary clauses.
+        //
+        const auto original = graph.topological_order();
+        const auto &gates = graph.get_gates();
+        for (auto i = original.rbegin(); i != original.rend(); i++) {
+            const int out = gates[*i]->get_PO();
+            if (kept[out])
+                continue;
+            const int a = gates[*i]->get_PIs()[0], b = gates[*i]->get_PIs()[1];
+            external->push_external_clause_and_witness_on_extension_stack(
+                {-a, -b, out}, {out}, ++clause_id);
+            external->push_external_clause_and_witness_on_extension_stack(
+                {-out, a}, {-out}, ++clause_id);
+            external->push_external_clause_and_witness_on_extension_stack(
+                {-out, b}, {-out}, ++clause_id);
+            stats.circuitrewrite.removed++;
+        }
+        stats.circuitrewrite.added += max_var - max_node;
+
+        // Original nodes map to their replacing literal if it is still in
+        // the graph (which is the node itself if kept) and to zero otherwise.
+        //
+        circuit_rewrite_map.assign(max_node + 1, 0);
+        for (int idx = 1; idx <= max_node; idx++) {
+            const int lit = rewriter.find(idx);
+            if (kept[abs(lit)] || !rewriter.is_and(abs(lit)))
+                circuit_rewrite_map[idx] = lit;
+        }
+
+        MSG ("rewriting reduced %d to %zd AND gates in %d rounds (%" PRId64
+             " rewrites, %d new nodes)", graph.get_num_gates(), order.size(),
+             round, rewriter.rewritten, max_var - max_node);
+    }
+    STOP (rewrite);
+    return res;
+}
+
+} // namespace CaDiCaL
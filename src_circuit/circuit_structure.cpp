@@ -0,0 +1,268 @@
+#include "../src/internal.hpp"
+
+#include <iterator>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Structural analysis of the parsed AIG for probing.  A gate is a
+// reconvergence point if its two inputs have a common ancestor (the stem)
+// within 'circuitreconvdepth' levels.  Implications hidden by reconvergent
+// fanout are usually not found by failed literal probing from the roots of
+// the binary implication graph.  Thus reconvergence points, their stems
+// and high-fanout gate outputs are scheduled as additional probes, and
+// recursive learning is applied to the reconvergence points.
+//
+// Recursive learning (Kunz and Pradhan) assumes that the output of a gate
+// is false, which has to be justified by one of its inputs being false.
+// Literals implied under every consistent justification are implied by the
+// false output and are added as (redundant) binary gates.  If no
+// justification is consistent, the output is a unit.  Within each
+// justification further unjustified gates are handled recursively up to
+// the depth given by 'circuitreclearn'.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Find reconvergence points, stems and high-fanout nodes once.
+ */
+void Internal::circuit_analyze_structure() {
+    if (circuit_structure_analyzed)
+        return;
+    circuit_structure_analyzed = true;
+    if (!circuit_graph)
+        return;
+
+    const Circuit_Graph &graph = *circuit_graph;
+    const auto &gates = graph.get_gates();
+    const int max_node = graph.get_max_var();
+    const int depth = opts.circuitreconvdepth;
+
+    std::vector<int> defining(max_node + 1, -1);
+    for (size_t i = 0; i < gates.size(); i++)
+        defining[gates[i]->get_PO()] = i;
+    const std::vector<int> fanouts = graph.compute_fanouts();
+
+    std::vector<int64_t> stamps(max_node + 1, 0);
+    std::vector<char> structural(max_node + 1, 0);
+    std::vector<int> frontier, next;
+    int64_t stamp = 0;
+
+    // Mark the ancestors of 'root' up to 'depth' levels with 'stamp' or, if
+    // 'find' is set, return the first one already marked.
+    //
+    auto ancestors = [&](int root, bool find) {
+        frontier.assign(1, abs(root));
+        for (int d = 0; d <= depth && !frontier.empty(); d++) {
+            next.clear();
+            for (const auto idx : frontier) {
+                if (!find)
+                    stamps[idx] = stamp;
+                else if (stamps[idx] == stamp)
+                    return idx;
+                if (d == depth || defining[idx] < 0)
+                    continue;
+                for (const auto input : gates[defining[idx]]->get_PIs())
+                    next.push_back(abs(input));
+            }
+            swap(frontier, next);
+        }
+        return 0;
+    };
+
+    for (size_t i = 0; i < gates.size(); i++) {
+        const auto &inputs = gates[i]->get_PIs();
+        const int output = gates[i]->get_PO();
+        if (fanouts[output] >= opts.circuitprobefanout)
+            structural[output] = 1;
+        if (inputs.size() != 2)
+            continue;
+        ++stamp;
+        ancestors(inputs[0], false);
+        const int stem = ancestors(inputs[1], true);
+        if (!stem)
+            continue;
+        circuit_reconvergent_gates.push_back(i);
+        structural[output] = 1;
+        structural[stem] = 1;
+    }
+
+    for (int idx = 1; idx <= max_node; idx++)
+        if (structural[idx])
+            circuit_structural_nodes.push_back(idx);
+
+    // Probes and recursive learning candidates are taken from the back.
+    //
+    stable_sort(circuit_structural_nodes.begin(), circuit_structural_nodes.end(),
+                [&fanouts](int a, int b) { return fanouts[a] < fanouts[b]; });
+    stable_sort(circuit_reconvergent_gates.begin(), circuit_reconvergent_gates.end(),
+                [&](int a, int b) {
+                    return fanouts[gates[a]->get_PO()] < fanouts[gates[b]->get_PO()];
+                });
+
+    PHASE ("structure", stats.probingphases,
+           "found %zd reconvergent gates and %zd structural probe nodes",
+           circuit_reconvergent_gates.size(), circuit_structural_nodes.size());
+}
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Literals implied by all consistent justifications of the false
+ *          output of 'gate', which is assigned and propagated.
+ * @return  false if no justification is consistent
+ */
+bool Internal::circuit_justify(const Circuit_LogicGate *gate, int depth,
+                               std::vector<int> &res) {
+    assert(res.empty());
+    const int base = level;
+    bool consistent = false;
+    std::vector<int> implied;
+
+    for (const auto input : gate->get_PIs()) {
+        const int justification = -input;
+        const signed char tmp = val(justification);
+        if (tmp > 0) {
+            // Already justified, thus nothing is implied beyond the
+            // current assignment.
+            //
+            res.clear();
+            return true;
+        }
+        if (tmp < 0)
+            continue;
+        if (circuit_reclearn_budget <= 0) {
+            res.clear();
+            return true;
+        }
+        circuit_reclearn_budget--;
+
+        circuit_search_assume_decision(justification);
+        bool ok = circuit_propagate();
+        implied.clear();
+        if (ok) {
+            const size_t start = control[base + 1].trail;
+            for (size_t i = start; i < trail.size(); i++)
+                implied.push_back(trail[i]);
+
+            if (depth > 1) {
+                const size_t size = implied.size();
+                for (size_t i = 0; ok && i < size; i++) {
+                    const int lit = implied[i];
+                    if (lit > 0 || !circuit_graph)
+                        continue;
+                    const int g = circuit_defining_gates[-lit];
+                    if (g < 0)
+                        continue;
+                    std::vector<int> sub;
+                    ok = circuit_justify(circuit_graph->get_gates()[g], depth - 1, sub);
+                    implied.insert(implied.end(), sub.begin(), sub.end());
+                }
+            }
+        }
+
+        circuit_backtrack(base);
+        circuit_conflict_clear();
+        if (!ok)
+            continue;
+
+        sort(implied.begin(), implied.end());
+        if (!consistent)
+            res.swap(implied);
+        else {
+            std::vector<int> common;
+            set_intersection(res.begin(), res.end(), implied.begin(), implied.end(),
+                             back_inserter(common));
+            res.swap(common);
+        }
+        consistent = true;
+    }
+
+    return consistent;
+}
+
+/**
+ * @brief:  Apply recursive learning to reconvergent gates at the root.
+ * @note:   Skipped while tracing proofs, since the learned binary gates are
+ *          not reverse unit propagation implied.
+ */
+void Internal::circuit_recursive_learning() {
+    if (!opts.circuitreclearn || !circuit_graph || proof || unsat)
+        return;
+    assert(!level);
+    circuit_analyze_structure();
+    if (circuit_reconvergent_gates.empty())
+        return;
+
+    START (reclearn);
+
+    if (circuit_defining_gates.empty()) {
+        const auto &gates = circuit_graph->get_gates();
+        circuit_defining_gates.assign(max_var + 1, -1);
+        for (size_t i = 0; i < gates.size(); i++)
+            circuit_defining_gates[gates[i]->get_PO()] = i;
+    }
+
+    // Decisions would overwrite the saved phases.
+    //
+    const std::vector<signed char> saved(phases.saved.begin(), phases.saved.end());
+
+    circuit_reclearn_budget = opts.circuitreclearnlim;
+    const int64_t old_binaries = stats.reclearned;
+    const int64_t old_units = stats.reclearnunits;
+    const size_t size = circuit_reconvergent_gates.size();
+    std::vector<int> common;
+
+    for (size_t n = 0; n < size && !unsat && circuit_reclearn_budget > 0; n++) {
+        if (terminated_asynchronously())
+            break;
+        if (circuit_reclearn_next >= size)
+            circuit_reclearn_next = 0;
+        const int g = circuit_reconvergent_gates[size - 1 - circuit_reclearn_next++];
+        const Circuit_LogicGate *gate = circuit_graph->get_gates()[g];
+        const int output = gate->get_PO();
+        if (!active(output))
+            continue;
+
+        const int assumption = -output;
+        circuit_search_assume_decision(assumption);
+        common.clear();
+        const bool consistent = circuit_propagate() &&
+                                circuit_justify(gate, opts.circuitreclearn, common);
+        circuit_backtrack();
+        circuit_conflict_clear();
+
+        if (!consistent) {
+            LOG ("recursive learning unit %d", output);
+            stats.reclearnunits++;
+            circuit_assign_unit(output);
+            if (!circuit_propagate())
+                circuit_learn_empty_clause();
+            continue;
+        }
+
+        for (const auto lit : common) {
+            if (val(lit) || abs(lit) == output)
+                continue;
+            LOG ("recursive learning implication %d -> %d", assumption, lit);
+            stats.reclearned++;
+            assert(clause.empty());
+            clause.push_back(assumption);
+            clause.push_back(-lit);
+            circuit_new_hyper_binary_resolved_clause(true, 2);
+            clause.clear();
+        }
+    }
+
+    for (auto idx : vars)
+        phases.saved[idx] = saved[idx];
+
+    PHASE ("reclearn", stats.probingphases,
+           "learned %" PRId64 " binary gates and %" PRId64 " units",
+           stats.reclearned - old_binaries, stats.reclearnunits - old_units);
+
+    STOP (reclearn);
+}
+
+} // namespace CaDiCaL
@@ -91,7 +91,9 @@ inline void Internal::circuit_subsume_clause(Circuit_Gate *subsuming, Circuit_Ga
         return;
     }
     LOG ("turning redundant subsuming clause into irredundant clause");
+    circuit_account_gate(subsuming, - (int64_t) subsuming->bytes());
     subsuming->redundant = false;
+    circuit_account_gate(subsuming, subsuming->bytes());
     circuit_mark_garbage(subsumed);
     stats.current.irredundant++;
     stats.added.irredundant++;
@@ -109,6 +111,10 @@ void Internal::circuit_strengthen_clause(Circuit_Gate *c, int lit) {
     stats.strengthened++;
     assert(c->size > 2);
     
+    if (proof)
+        circuit_proof_strengthen_gate(c, lit);
+    lrat_chain.clear();
+
     auto new_end = remove(c->begin(), c->end(), lit);
     assert (new_end + 1 == c->end ()), (void) new_end;
     (void)circuit_shrink_gate(c, c->size - 1);
@@ -152,14 +158,33 @@ inline int Internal::circuit_try_to_subsume_clause(Circuit_Gate *c, vector<Circu
             if (d)
                 break;
 
+            // Signatures of connected gates are stored next to the occurrence
+            // list and checked in blocks without branches (which compilers
+            // vectorize), before the remaining candidates are checked with
+            // marks.  A gate with a variable not in 'c' can neither subsume
+            // nor strengthen 'c'.
+            //
             const Circuit_Occs &os = circuit_occs(sign * lit);
-            for (const auto &e : os) {
-                assert(!e->garbage);
-                flipped = circuit_subsume_check(e, c);
-                if (!flipped)
-                    continue;
-                d = e;
-                break;
+            const vector<uint64_t> &sigs = circuit_osigs[vlit (sign * lit)];
+            assert(sigs.size() == os.size());
+            const uint64_t signature = c->signature;
+            const size_t size = os.size();
+            for (size_t begin = 0; !d && begin < size; begin += 32) {
+                const size_t end = min(size, begin + 32);
+                uint32_t candidates = 0;
+                for (size_t i = begin; i < end; i++)
+                    candidates |= (uint32_t) !(sigs[i] & ~signature) << (i - begin);
+                stats.subsigs += (end - begin) - __builtin_popcount(candidates);
+                while (candidates) {
+                    Circuit_Gate *e = os[begin + __builtin_ctz(candidates)];
+                    candidates &= candidates - 1;
+                    assert(!e->garbage);
+                    flipped = circuit_subsume_check(e, c);
+                    if (!flipped)
+                        continue;
+                    d = e;
+                    break;
+                }
             }
         }
         if (d)
@@ -174,6 +199,11 @@ inline int Internal::circuit_try_to_subsume_clause(Circuit_Gate *c, vector<Circu
     }
 
     if (flipped) {
+        if (lrat) {
+            assert (lrat_chain.empty());
+            lrat_chain.push_back(d->id);
+            lrat_chain.push_back(c->id);
+        }
         circuit_strengthen_clause(c, -flipped);
         shrunken.push_back(c);
         return -1;
@@ -304,7 +334,12 @@ bool Internal::circuit_subsume_round() {
     //
     rsort (schedule.begin (), schedule.end (), circuit_smaller_clause_size_rank ());
 
-    if (!left_over_from_last_subsumption_round)
+    // Gates are flagged as candidates when added or shrunk (which includes
+    // strengthening), and keep the flag until checked, so left over ones of
+    // an incomplete round are checked in the next round.  Unless 'subsumeinc' is enabled
+    // all gates are candidates again.  All gates are still connected below.
+    //
+    if (!opts.subsumeinc && !left_over_from_last_subsumption_round)
         for (auto cs : schedule)
             if (cs.gate->size > 2)
                 cs.gate->subsume = true;
@@ -329,6 +364,7 @@ bool Internal::circuit_subsume_round() {
     vector<Circuit_Gate *> shrunken;
     circuit_init_occs();
     circuit_init_bins();
+    circuit_osigs.resize(circuit_otab.size());
 
     for (const auto &s : schedule) {
         if (terminated_asynchronously ())
@@ -394,6 +430,7 @@ bool Internal::circuit_subsume_round() {
                 continue;
 
             circuit_occs(minlit).push_back(c);
+            circuit_osigs[vlit (minlit)].push_back(c->signature);
             // This sorting should give faster failures for assumption checks
             // since the less occurring variables are put first in a clause and
             // thus will make it more likely to be found as witness for a clause
@@ -439,6 +476,7 @@ bool Internal::circuit_subsume_round() {
     erase_vector (schedule);
     reset_noccs ();
     circuit_reset_occs ();
+    erase_vector (circuit_osigs);
     circuit_reset_bins ();
 
     // Reset all old 'added' flags and mark variables in shrunken
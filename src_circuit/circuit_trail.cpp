@@ -0,0 +1,52 @@
+#include "../src/internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Trail saving.  Backjumping after a conflict and restarts unassign many
+// literals which are assigned again in the same order right afterwards.
+// Thus the unassigned segment of the trail is saved together with the
+// reasons of its literals.  When propagation reaches a literal at the head
+// of the saved trail, the implied literals following it are assigned right
+// away with their saved reasons, as long as these reasons are still valid
+// (the gate is not garbage and all its other literals are true).  Saved
+// literals which are already true are skipped, while a false literal or an
+// invalid reason discards the saved trail.  Replay stops at the next saved
+// decision and continues when propagation reaches that literal again.
+//
+// The assigned literals are propagated as usual, thus replay only saves the
+// watch visits needed to find the implications, and since replayed
+// literals are assigned with their actual reasons, it is sound even if the
+// search deviates from the saved trail.  Replay is implemented next to
+// 'circuit_propagate' in 'circuit_propagate.cpp'.
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * @brief:  Save the literals on the trail assigned at levels above
+ *          'new_level' up to 'max_level' before backtracking to 'new_level'.
+ */
+void Internal::circuit_save_trail(int new_level, int max_level) {
+    circuit_clear_saved_trail();
+    if (!opts.circuittrailsave || new_level >= max_level)
+        return;
+    for (size_t i = control[new_level + 1].trail; i < trail.size(); i++) {
+        const int lit = trail[i];
+        const Var &v = var(lit);
+        if (v.level <= new_level || v.level > max_level)
+            continue;
+        circuit_saved_trail.push_back({lit, v.circuit_reason_direct, v.circuit_reason});
+    }
+    stats.circuittrail.saved += circuit_saved_trail.size();
+}
+
+/**
+ * @brief:  Discard the saved trail, necessary before deleting gates.
+ */
+void Internal::circuit_clear_saved_trail() {
+    circuit_saved_trail.clear();
+    circuit_saved_pos = 0;
+}
+
+} // namespace CaDiCaL
@@ -149,6 +149,8 @@ void Internal::circuit_transred() {
                     continue;
                 if (irredundant && d->redundant)
                     continue;
+                if (d->garbage)
+                    continue;
                 const int other = w.blit;
                 if (other == dst)
                     transitive = true; // 'dst' reached
@@ -180,7 +182,7 @@ void Internal::circuit_transred() {
             stats.transitive++;
 //            LOG (c, "transitive redundant");
             circuit_mark_garbage (c);
-        } else if (failed) {
+        } else if (failed && !lrat) {   // no chain for the implication path
             units++;
             stats.failed++;
             stats.transredunits++;
@@ -14,15 +14,41 @@ void Internal::circuit_init_watches () {
 void Internal::circuit_clear_watches () {
     for (auto lit : lits)
         circuit_watches (lit).clear ();
+    circuit_suspended.clear ();
+    circuit_clear_saved_trail ();
 }
 
 /// @note:  watch.cpp:  reset_watches()
 void Internal::circuit_reset_watches() {
     assert(!circuit_wtab.empty());
     erase_vector(circuit_wtab);
+    circuit_suspended.clear();
+    circuit_clear_saved_trail();
     LOG ("reset watcher tables");
 }
 
+/**
+ * @brief:  Reconnect the watches suspended at levels above 'new_level'.
+ * @note:   The gate of a suspended watch of 'lit' stays watched by 'lit'
+ *          since only visiting that watch moves it.  If 'lit' is still
+ *          assigned (out-of-order with chronological backtracking) while
+ *          its blocking literal was unassigned, 'lit' is propagated again.
+ */
+void Internal::circuit_restore_watches (int new_level) {
+    for (int l = (int) circuit_suspended.size() - 1; l > new_level; l--) {
+        auto &suspended = circuit_suspended[l];
+        for (const auto &s : suspended) {
+            circuit_watches (s.lit).push_back (s.watch);
+            if (val (s.lit) > 0 && !val (s.watch.blit)) {
+                const size_t pos = var (s.lit).trail;
+                if (pos < propagated)
+                    propagated = pos;
+            }
+        }
+        suspended.clear();
+    }
+}
+
 // This can be quite costly since lots of memory is accessed in a rather
 // random fashion, and thus we optionally profile it.
 
@@ -20,6 +20,23 @@ struct Circuit_Watch {
 
 typedef std::vector<Circuit_Watch> Circuit_Watches;  // of one literal
 
+// Watch of 'lit' removed from its watch list while the gate is satisfied by
+// the blocking literal assigned at a lower (non-root) decision level.
+struct Circuit_Suspended_Watch {
+    int lit;
+    Circuit_Watch watch;
+};
+
+typedef std::vector<Circuit_Suspended_Watch> Circuit_Suspended_Watches;  // of one level
+
+// Literal unassigned by backtracking with the reason it was assigned with
+// (none for decisions), which is replayed if still valid (see 'circuit_trail.cpp').
+struct Circuit_Saved_Literal {
+    int lit;
+    int reason_direct;
+    Circuit_Gate *reason;
+};
+
 typedef Circuit_Watches::iterator circuit_watch_iterator;
 typedef Circuit_Watches::const_iterator circuit_const_watch_iterator;
 
@@ -56,12 +56,12 @@ char *read_int(char *p, int *i) {                           // Aid function for
 }
 
 int EasySAT_Solver::add_clause(std::vector<int> &c) {                   
-    clause_DB.push_back(EasySAT_Clause(c.size()));                          // Add a clause c into database.
-    int id = clause_DB.size() - 1;                                  // Getting clause index.
-    for (int i = 0; i < (int)c.size(); i++) clause_DB[id][i] = c[i];     // Copy literals
-    watch(-c[0]).push_back(Watcher(id, c[1]));                      // Watch this clause by literal -c[0]
-    watch(-c[1]).push_back(Watcher(id, c[0]));                      // Watch this clause by literal -c[1]
-    return id;                                                      
+    int cref = clause_DB.size();                                    // Clause reference is the arena offset.
+    clause_DB.push_back(c.size()), clause_DB.push_back(0);          // Header with size and LBD.
+    clause_DB.insert(clause_DB.end(), c.begin(), c.end());          // Copy literals
+    watch(-c[0]).push_back(Watcher(cref, c[1]));                    // Watch this clause by literal -c[0]
+    watch(-c[1]).push_back(Watcher(cref, c[0]));                    // Watch this clause by literal -c[1]
+    return cref;                                                      
 }
 
 int EasySAT_Solver::parse(char *filename) {
@@ -93,18 +93,37 @@ int EasySAT_Solver::parse(char *filename) {
             if (*p == '\0' && dimacs_lit != 0)                                              // Unexpected EOF
                 printf("c PARSE ERROR! Unexpected EOF\n"), exit(1);
             if (dimacs_lit == 0) {                                                          // Finish read a clause.
-                if (buffer.size() == 0) return 20;                                          // Read an empty clause.
-                if (buffer.size() == 1 && value(buffer[0]) == -1) return 20;                // Found confliction in origin clauses
-                if (buffer.size() == 1 && !value(buffer[0])) assign(buffer[0], 0, -1);      // Found an unit clause.
-                else if (buffer.size() > 1) add_clause(buffer);                             // Found a clause who has more than 1 literals.
+                if (add_original(buffer) == 20) return 20;                                  // Found confliction in origin clauses
                 buffer.clear();                                                             // For the next clause.
             }       
             else buffer.push_back(dimacs_lit);                                              // read a literal
         }
     }
-    origin_clauses = clause_DB.size();
     STOP (parse);
-    return (propagate() == -1 ? 0 : 20);                                                    // Simplify by BCP.
+    return finish_original();
+}
+
+int EasySAT_Solver::add_original(std::vector<int> &c) {
+    int size = 0;
+    for (int i = 0; i < (int)c.size(); i++) {                       // Remove duplicated literals.
+        int j = 0;
+        while (j < size && c[j] != c[i]) {
+            if (c[j] == -c[i]) return 0;                            // Skip tautological clauses.
+            j++;
+        }
+        if (j == size) c[size++] = c[i];
+    }
+    c.resize(size);
+    if (c.size() == 0) return 20;                                   // Read an empty clause.
+    if (c.size() == 1 && value(c[0]) == -1) return 20;              // Found confliction in origin clauses
+    if (c.size() == 1 && !value(c[0])) assign(c[0], 0, -1);         // Found an unit clause.
+    else if (c.size() > 1) add_clause(c);                           // Found a clause who has more than 1 literals.
+    return 0;
+}
+
+int EasySAT_Solver::finish_original() {
+    origin_size = clause_DB.size();
+    return (propagate() == -1 ? 0 : 20);                            // Simplify by BCP.
 }
 
 void EasySAT_Solver::alloc_memory() {
@@ -155,14 +174,14 @@ int EasySAT_Solver::propagate() {
                 ws[j++] = ws[i++]; continue;
             }
             int cref = ws[i].idx_clause, k, sz;
-            EasySAT_Clause& c = clause_DB[cref];                // Fetch a clause from watcher
+            EasySAT_Clause& c = clause(cref);           // Fetch a clause from watcher
             if (c[0] == -p) c[0] = c[1], c[1] = -p;     // Make sure c[1] is the false literal (-p).
             Watcher w = Watcher(cref, c[0]);            // Prepare a new watcher for c[1]
             i++;
             if (value(c[0]) == 1) {                     // Check whether another lit is SAT.
                 ws[j++] = w; continue;
             }
-            for (k = 2, sz = c.lit.size(); k < sz && value(c[k]) == -1; k++);    // Find a new watch literal.
+            for (k = 2, sz = c.size; k < sz && value(c[k]) == -1; k++);          // Find a new watch literal.
             if (k < sz) {                               // Move the watch literal to the second place
                 c[1] = c[k], c[k] = -p;
                 watch(-c[1]).push_back(w);
@@ -189,7 +208,7 @@ int EasySAT_Solver::analyze(int conflict, int &backtrackLevel, int &lbd) {
 
     ++time_stamp;
     learnt.clear();
-    EasySAT_Clause &c = clause_DB[conflict]; 
+    EasySAT_Clause &c = clause(conflict); 
     int highestLevel = level[abs(c[0])];
     if (highestLevel == 0) return 20;
     learnt.push_back(0);        // leave a place to save the First-UIP
@@ -198,8 +217,8 @@ int EasySAT_Solver::analyze(int conflict, int &backtrackLevel, int &lbd) {
         resolve_lit = 0,        // The literal to do resolution.
         index = trail.size() - 1;
     do {
-        EasySAT_Clause &c = clause_DB[conflict];
-        for (int i = (resolve_lit == 0 ? 0 : 1); i < (int)c.lit.size(); i++) {
+        EasySAT_Clause &c = clause(conflict);
+        for (int i = (resolve_lit == 0 ? 0 : 1); i < c.size; i++) {
             int var = abs(c[i]);
             if (mark[var] != time_stamp && level[var] > 0) {
                 bump_var(var, 0.5);
@@ -292,22 +311,26 @@ void EasySAT_Solver::reduce() {
 
     backtrack(0);
     reduces = 0, reduce_limit += 512;
-    int new_size = origin_clauses, old_size = clause_DB.size();
-    reduce_map.resize(old_size);
-    for (int i = origin_clauses; i < old_size; i++) {    // random delete 50% bad clauses (LBD>=5)
-        if (clause_DB[i].lbd >= 5 && rand() % 2 == 0) reduce_map[i] = -1;  // remove clause
-        else {
-            if (new_size != i) clause_DB[new_size] = clause_DB[i];
-            reduce_map[i] = new_size++;
+    int new_size = origin_size, old_size = clause_DB.size();
+    reduce_refs.clear(), reduce_map.clear();
+    for (int i = origin_size; i < old_size; ) {     // random delete 50% bad clauses (LBD>=5)
+        int words = EasySAT_Clause::words(clause(i).size);
+        reduce_refs.push_back(i);
+        if (clause(i).lbd >= 5 && rand() % 2 == 0) reduce_map.push_back(-1);  // remove clause
+        else {                                      // compact in place
+            if (new_size != i) std::copy(&clause_DB[i], &clause_DB[i] + words, &clause_DB[new_size]);
+            reduce_map.push_back(new_size), new_size += words;
         }
+        i += words;
     }
-    clause_DB.resize(new_size, EasySAT_Clause(0));
+    clause_DB.resize(new_size);
     for (int v = -vars; v <= vars; v++) {   // Update the watches.
         if (v == 0) continue;
         int old_sz = watch(v).size(), new_sz = 0;
         for (int i = 0; i < old_sz; i++) {
-            int old_idx = watch(v)[i].idx_clause;
-            int new_idx = old_idx < origin_clauses ? old_idx : reduce_map[old_idx];
+            int old_idx = watch(v)[i].idx_clause, new_idx = old_idx;
+            if (old_idx >= origin_size)         // learnt clause references are sorted
+                new_idx = reduce_map[std::lower_bound(reduce_refs.begin(), reduce_refs.end(), old_idx) - reduce_refs.begin()];
             if (new_idx != -1) {
                 watch(v)[i].idx_clause = new_idx;
                 if (new_sz != i) watch(v)[new_sz] = watch(v)[i];
@@ -337,7 +360,7 @@ int EasySAT_Solver::solve() {
             if (learnt.size() == 1) assign(learnt[0], 0, -1);   // Learnt a unit clause.
             else {                     
                 int cref = add_clause(learnt);                  // Add a clause to data base.
-                clause_DB[cref].lbd = lbd;              
+                clause(cref).lbd = lbd;              
                 assign(learnt[0], backtrackLevel, cref);        // The learnt clause implies the assignment of the UIP variable.
             }
             var_inc *= (1 / 0.8);                               // var_decay for locality
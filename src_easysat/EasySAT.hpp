@@ -30,17 +30,18 @@ SOFTWARE.
 
 namespace CaDiCaL {
 
-class EasySAT_Clause {
+class EasySAT_Clause {         // A clause stored inline in the clause arena.
 public:
-    int lbd;                    // Literal Block Distance (Gilles & Laurent, IJCAI 2009)
-    std::vector<int> lit;       // Literals in this clause
-    EasySAT_Clause(int sz): lbd(0) { lit.resize(sz); }
+    int size,                   // The number of literals.
+        lbd;                    // Literal Block Distance (Gilles & Laurent, IJCAI 2009)
+    int lit[2];                 // Literals in this clause (actually 'size' many).
     int& operator [] (int index) { return lit[index]; }
+    static int words(int size) { return size + 2; }        // Arena size of a clause.
 };
 
 class Watcher {
 public:
-    int idx_clause              // The clause index in clause database.
+    int idx_clause              // The clause reference (offset) in clause arena.
         , blocker;              // Used to fast guess whether a clause is already satisfied. 
     Watcher(): idx_clause(0), blocker(0) {}
     Watcher(int c, int b): idx_clause(c), blocker(b) {}
@@ -55,13 +56,14 @@ struct GreaterActivity {        // A compare function used to sort the activitie
 
 class EasySAT_Solver {
 public:
-    std::vector<int>    learnt,                     // The clause indices of the learnt clauses.
+    std::vector<int>    learnt,                     // The learnt clause of the last conflict.
                         trail,                      // Save the assigned literal sequence.
                         pos_in_trail,               // Save the decision variables' position in trail.
-                        reduce_map;                 // Auxiliary data structure for clause management.
-    std::vector<EasySAT_Clause> clause_DB;                  // clause database.
+                        reduce_refs, reduce_map,    // Auxiliary data structure for clause management.
+                        clause_DB;                  // clause arena (size, LBD and literals of each clause).
     std::vector<Watcher> *watches;                  // A mapping from literal to clauses.
-    int vars, clauses, origin_clauses, conflicts;   // the number of variables, clauses, conflicts.
+    int vars, clauses, conflicts;                   // the number of variables, clauses, conflicts.
+    int origin_size;                                // The arena size of the original clauses.
     int restarts, rephases, reduces;                // the number of conflicts since the last ... .
     int rephase_limit, reduce_limit;                // parameters for when to conduct rephase and reduce.
     int threshold;                                  // A threshold for updating the local_best phase.
@@ -90,7 +92,10 @@ public:
     int  parse(char *filename);                             // Read CNF file.
     int  solve();                                           // Solving.
     int  decide();                                          // Pick desicion variable.
+    EasySAT_Clause& clause(int cref) { return *(EasySAT_Clause*) &clause_DB[cref]; }
     int  add_clause(std::vector<int> &c);                    // add new clause to clause database.
+    int  add_original(std::vector<int> &c);                  // add input clause (20 if trivially unsat).
+    int  finish_original();                                 // simplify input clauses by BCP.
     void bump_var(int var, double mult);                     // update activity      
     void restart();                                         // do restart.                                      
     void reduce();                                          // do clause management.
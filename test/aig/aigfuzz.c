@@ -0,0 +1,582 @@
+/*
+ * Differential fuzzer of the circuit engine.  It generates small random
+ * AIGs, solves them in the circuit modes of the solver ('--satsolvermode')
+ * and compares the results against the solver on the Tseitin encoding in
+ * DIMACS format, i.e., plain CNF mode.  Satisfying assignments are checked
+ * by simulating the AIG on the returned input values.  Failing AIGs are
+ * written to '<prefix><seed>.aag' and then shrunken by substituting gates
+ * by their inputs and removing outputs as long as the same failure occurs,
+ * which results in '<prefix><seed>-red.aag'.
+ *
+ * Every run is determined by its seed, thus a failure can be reproduced
+ * with 'aigfuzz -s <seed> -n 1' (and the same solver options).
+ */
+#include <assert.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static void die (const char *msg, ...) {
+  va_list ap;
+  fputs ("*** aigfuzz: ", stderr);
+  va_start (ap, msg);
+  vfprintf (stderr, msg, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+static void msg (const char *msg, ...) {
+  va_list ap;
+  fputs ("aigfuzz: ", stdout);
+  va_start (ap, msg);
+  vprintf (msg, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+}
+
+static void *allocate (size_t bytes) {
+  void *res = malloc (bytes ? bytes : 1);
+  if (!res)
+    die ("out of memory");
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static const char *usage =
+    "usage: aigfuzz [ <option> ... ] [ -- <solver-option> ... ]\n"
+    "\n"
+    "where '<option>' is one of the following\n"
+    "\n"
+    "  -h          print this command line option summary\n"
+    "  -q          only report failures and the final summary\n"
+    "  -k          keep going after a failure\n"
+    "  -f          do not randomize solver options\n"
+    "  -s <seed>   seed of the first run (default from time and pid)\n"
+    "  -n <runs>   number of runs (default 0 means unlimited)\n"
+    "  -b <path>   solver binary (default './cadical')\n"
+    "  -m <modes>  circuit modes to check (default '13', mode '2' has\n"
+    "              no witness thus only its status is compared)\n"
+    "  -t <sec>    time limit per solver call (default 10)\n"
+    "  -p <prefix> prefix of failing AIGs (default 'bug-')\n"
+    "\n"
+    "and '<solver-option>' is passed to all circuit mode solver calls.\n";
+
+static int quiet, keep_going, fixed;
+static const char *solver = "./cadical";
+static const char *modes = "13";
+static const char *prefix = "bug-";
+static unsigned time_limit = 10;
+static char extra[1024];
+
+static char aag_path[256], cnf_path[256];
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t state;
+
+static uint64_t next (void) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static unsigned pick (unsigned n) { return next () % n; }
+
+static void seed_rng (uint64_t seed) {
+  state = 0x9e3779b97f4a7c15ull ^ (seed * 0xbf58476d1ce4e5b9ull);
+  if (!state)
+    state = 1;
+  next ();
+}
+
+/*------------------------------------------------------------------------*/
+
+// The variables of the inputs are '1..inputs', followed by the variables of
+// the gates in topological order, thus 'lhs' of gate 'i' is implicit.  The
+// engine does not support the constants '0' and '1' (and treats AIGs
+// without gates as unsatisfiable), thus they are never generated.
+
+typedef struct Gate {
+  unsigned rhs0, rhs1;
+} Gate;
+
+typedef struct AIG {
+  unsigned inputs, num_gates, num_outputs;
+  Gate *gates;
+  unsigned *outputs;
+} AIG;
+
+static unsigned max_var (const AIG *aig) {
+  return aig->inputs + aig->num_gates;
+}
+
+static unsigned lhs (const AIG *aig, unsigned i) {
+  return 2 * (aig->inputs + 1 + i);
+}
+
+static AIG *new_aig (unsigned inputs, unsigned num_gates,
+                     unsigned num_outputs) {
+  AIG *res = allocate (sizeof *res);
+  res->inputs = inputs;
+  res->num_gates = num_gates;
+  res->num_outputs = num_outputs;
+  res->gates = allocate (num_gates * sizeof *res->gates);
+  res->outputs = allocate (num_outputs * sizeof *res->outputs);
+  return res;
+}
+
+static void delete_aig (AIG *aig) {
+  free (aig->gates), free (aig->outputs), free (aig);
+}
+
+// Gates take their inputs mostly from recent nodes to get deep AIGs with
+// reconvergence, and sometimes from the same variable ('x & x', 'x & !x').
+
+static AIG *generate (void) {
+  const unsigned inputs = 1 + pick (pick (4) ? 12 : 40);
+  const unsigned num_gates = 1 + pick (pick (4) ? 60 : 400);
+  const unsigned num_outputs = 1 + (pick (3) ? 0 : pick (3));
+  AIG *aig = new_aig (inputs, num_gates, num_outputs);
+  for (unsigned i = 0; i < num_gates; i++) {
+    const unsigned vars = inputs + i;
+    unsigned lits[2];
+    for (unsigned j = 0; j < 2; j++) {
+      unsigned var;
+      if (pick (2))
+        var = 1 + pick (vars);
+      else
+        var = vars - pick (vars < 8 ? vars : 8);
+      lits[j] = 2 * var + (unsigned) (next () & 1);
+    }
+    if ((lits[0] >> 1) == (lits[1] >> 1) && pick (8))
+      lits[1] = 2 * (1 + pick (vars)) + (lits[1] & 1);
+    aig->gates[i].rhs0 = lits[0] > lits[1] ? lits[0] : lits[1];
+    aig->gates[i].rhs1 = lits[0] > lits[1] ? lits[1] : lits[0];
+  }
+  for (unsigned i = 0; i < num_outputs; i++) {
+    const unsigned g = num_gates - 1 - pick (num_gates < 4 ? num_gates : 4);
+    aig->outputs[i] = lhs (aig, g) + (unsigned) (next () & 1);
+  }
+  return aig;
+}
+
+static void write_aag (const AIG *aig, const char *path) {
+  FILE *file = fopen (path, "w");
+  if (!file)
+    die ("can not write '%s'", path);
+  fprintf (file, "aag %u %u 0 %u %u\n", max_var (aig), aig->inputs,
+           aig->num_outputs, aig->num_gates);
+  for (unsigned i = 1; i <= aig->inputs; i++)
+    fprintf (file, "%u\n", 2 * i);
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    fprintf (file, "%u\n", aig->outputs[i]);
+  for (unsigned i = 0; i < aig->num_gates; i++)
+    fprintf (file, "%u %u %u\n", lhs (aig, i), aig->gates[i].rhs0,
+             aig->gates[i].rhs1);
+  fclose (file);
+}
+
+static int dimacs (unsigned lit) {
+  return (lit & 1) ? -(int) (lit / 2) : (int) (lit / 2);
+}
+
+// Tseitin encoding with the same variable indices as the AIG.
+
+static void write_cnf (const AIG *aig, const char *path) {
+  FILE *file = fopen (path, "w");
+  if (!file)
+    die ("can not write '%s'", path);
+  fprintf (file, "p cnf %u %u\n", max_var (aig),
+           3 * aig->num_gates + aig->num_outputs);
+  for (unsigned i = 0; i < aig->num_gates; i++) {
+    const int g = dimacs (lhs (aig, i));
+    const int a = dimacs (aig->gates[i].rhs0);
+    const int b = dimacs (aig->gates[i].rhs1);
+    fprintf (file, "%d %d 0\n%d %d 0\n%d %d %d 0\n", -g, a, -g, b, g, -a,
+             -b);
+  }
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    fprintf (file, "%d 0\n", dimacs (aig->outputs[i]));
+  fclose (file);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Simulates the AIG on the input values of 'model' and returns whether all
+// outputs are true.
+
+static int simulate (const AIG *aig, const signed char *model) {
+  const unsigned n = max_var (aig);
+  unsigned char *vals = allocate (n + 1);
+  for (unsigned v = 1; v <= aig->inputs; v++)
+    vals[v] = model[v] > 0;
+  for (unsigned i = 0; i < aig->num_gates; i++) {
+    const unsigned a = aig->gates[i].rhs0, b = aig->gates[i].rhs1;
+    const unsigned va = vals[a / 2] ^ (a & 1), vb = vals[b / 2] ^ (b & 1);
+    vals[lhs (aig, i) / 2] = va & vb;
+  }
+  int res = 1;
+  for (unsigned i = 0; res && i < aig->num_outputs; i++) {
+    const unsigned o = aig->outputs[i];
+    res = vals[o / 2] ^ (o & 1);
+  }
+  free (vals);
+  return res;
+}
+
+// Result of a solver call, where 'status' is the exit code '10', '20' or
+// '0' (unknown) and negative if the solver crashed or returned something
+// else.  The model is only filled for satisfiable results.
+
+typedef struct Result {
+  int status;
+  signed char *model;
+} Result;
+
+static Result solve (const AIG *aig, const char *options, const char *path) {
+  char cmd[8192];
+  snprintf (cmd, sizeof cmd, "%s -t %u %s %s 2>&1", solver, time_limit,
+            options, path);
+  FILE *pipe = popen (cmd, "r");
+  if (!pipe)
+    die ("can not run '%s'", cmd);
+  Result res;
+  const unsigned n = max_var (aig);
+  res.model = allocate (n + 1);
+  memset (res.model, 0, n + 1);
+  char line[4096];
+  int s = 0;
+  while (fgets (line, sizeof line, pipe)) {
+    if (!strncmp (line, "s SATISFIABLE", 13))
+      s = 10;
+    else if (!strncmp (line, "s UNSATISFIABLE", 15))
+      s = 20;
+    else if (line[0] == 'v' && line[1] == ' ') {
+      char *p = line + 2, *end;
+      for (long lit; (lit = strtol (p, &end, 10)), end != p; p = end) {
+        const unsigned idx = lit < 0 ? -lit : lit;
+        if (idx && idx <= n)
+          res.model[idx] = lit < 0 ? -1 : 1;
+      }
+    }
+  }
+  const int wait = pclose (pipe);
+  if (!WIFEXITED (wait))
+    res.status = -1;
+  else {
+    res.status = WEXITSTATUS (wait);
+    if (res.status != 0 && res.status != 10 && res.status != 20)
+      res.status = -1;
+    else if (res.status != s)
+      res.status = -1;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+enum Failure {
+  NONE = 0,
+  CRASH = 1,        // abnormal exit code or signal
+  STATUS = 2,       // different status than CNF mode
+  WITNESS = 3,      // satisfying assignment fails simulation
+  REFERENCE = 4,    // CNF mode itself failed
+};
+
+static const char *failures[] = {"none", "crash", "status", "witness",
+                                 "reference"};
+
+static char options[1024];
+
+// Checks one circuit mode against CNF mode on the Tseitin encoding.
+
+static int check (const AIG *aig, char mode) {
+  write_aag (aig, aag_path);
+  write_cnf (aig, cnf_path);
+  int res = NONE;
+  Result ref = solve (aig, "", cnf_path);
+  if (ref.status < 0 || (ref.status == 10 && !simulate (aig, ref.model)))
+    res = REFERENCE;
+  else {
+    char tmp[4096];
+    snprintf (tmp, sizeof tmp, "--satsolvermode=%c%s%s", mode, options,
+              extra);
+    Result act = solve (aig, tmp, aag_path);
+    if (act.status < 0)
+      res = CRASH;
+    else if (act.status && ref.status && act.status != ref.status)
+      res = STATUS;
+    else if (act.status == 10 && mode != '2' && !simulate (aig, act.model))
+      res = WITNESS;
+    free (act.model);
+  }
+  free (ref.model);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Copies 'aig' with variable 'var' substituted by literal 'lit' (if 'var'
+// is non-zero) and the output 'skip' removed (if smaller than the number
+// of outputs), keeping only the inputs and gates in the cone of influence
+// of the remaining outputs.
+
+static AIG *reduce (const AIG *aig, unsigned var, unsigned lit,
+                    unsigned skip) {
+  const unsigned n = max_var (aig);
+  unsigned *subst = allocate ((2 * n + 2) * sizeof *subst);
+  for (unsigned l = 0; l < 2 * n + 2; l++)
+    subst[l] = l;
+  unsigned *map = allocate ((n + 1) * sizeof *map);
+  memset (map, 0, (n + 1) * sizeof *map);
+  if (var) {
+    subst[2 * var] = lit;
+    subst[2 * var + 1] = lit ^ 1;
+  }
+  const unsigned first = aig->inputs + 1;
+  for (unsigned i = 0; i < aig->num_outputs; i++)
+    if (i != skip)
+      map[subst[aig->outputs[i]] / 2] = 1;
+  for (unsigned v = n; v >= first; v--) {
+    if (!map[v] || v == var)
+      continue;
+    const Gate *g = aig->gates + (v - first);
+    map[subst[g->rhs0] / 2] = 1;
+    map[subst[g->rhs1] / 2] = 1;
+  }
+  unsigned inputs = 0, num_gates = 0;
+  for (unsigned v = 1; v <= n; v++) {
+    if (!map[v] || v == var)
+      map[v] = 0;
+    else if (v < first)
+      map[v] = ++inputs;
+    else
+      num_gates++;
+  }
+  unsigned num_outputs = aig->num_outputs - (skip < aig->num_outputs);
+  AIG *res = new_aig (inputs, num_gates, num_outputs);
+  unsigned next_var = inputs;
+#define MAP(L) (2 * map[subst[L] / 2] + (subst[L] & 1))
+  for (unsigned v = first; v <= n; v++) {
+    if (v == var || !map[v])
+      continue;
+    const Gate *g = aig->gates + (v - first);
+    Gate *h = res->gates + (next_var - inputs);
+    map[v] = ++next_var;
+    h->rhs0 = MAP (g->rhs0);
+    h->rhs1 = MAP (g->rhs1);
+    if (h->rhs0 < h->rhs1) {
+      const unsigned tmp = h->rhs0;
+      h->rhs0 = h->rhs1, h->rhs1 = tmp;
+    }
+  }
+  for (unsigned i = 0, j = 0; i < aig->num_outputs; i++)
+    if (i != skip)
+      res->outputs[j++] = MAP (aig->outputs[i]);
+#undef MAP
+  free (subst), free (map);
+  return res;
+}
+
+// Greedily applies reductions which preserve the failure until fix-point.
+
+static AIG *shrink (AIG *aig, char mode, int failure) {
+  unsigned reductions = 0;
+  for (int changed = 1; changed;) {
+    changed = 0;
+    for (unsigned i = 0; aig->num_outputs > 1 && i < aig->num_outputs;) {
+      AIG *tmp = reduce (aig, 0, 0, i);
+      if (tmp->num_gates && check (tmp, mode) == failure)
+        delete_aig (aig), aig = tmp, changed = 1, reductions++;
+      else
+        delete_aig (tmp), i++;
+    }
+    for (unsigned i = aig->num_gates; i--;) {
+      if (i >= aig->num_gates)
+        continue;
+      const unsigned var = lhs (aig, i) / 2;
+      const unsigned rhs[2] = {aig->gates[i].rhs0, aig->gates[i].rhs1};
+      for (unsigned j = 0; j < 2; j++) {
+        AIG *tmp = reduce (aig, var, rhs[j], aig->num_outputs);
+        if (tmp->num_gates && check (tmp, mode) == failure) {
+          delete_aig (aig), aig = tmp, changed = 1, reductions++;
+          break;
+        }
+        delete_aig (tmp);
+      }
+    }
+  }
+  if (!quiet)
+    msg ("applied %u reductions", reductions);
+  return aig;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Random solver options, chosen to trigger inprocessing on small AIGs.
+
+static void randomize_options (void) {
+  options[0] = 0;
+  if (fixed)
+    return;
+  size_t len = 0;
+#define ADD(...) \
+  len += snprintf (options + len, sizeof options - len, __VA_ARGS__)
+  if (pick (2))
+    ADD (" --probeint=%u", 1 + pick (100));
+  if (pick (2))
+    ADD (" --subsumeint=%u", 1 + pick (100));
+  if (pick (2))
+    ADD (" --elimint=%u", 1 + pick (100));
+  if (pick (2))
+    ADD (" --reduceint=%u", 10 + pick (100));
+  if (pick (2))
+    ADD (" --restartint=%u", 1 + pick (10));
+  if (pick (2))
+    ADD (" --rephaseint=%u", 1 + pick (100));
+  if (pick (2))
+    ADD (" --chrono=%u", pick (3));
+  if (pick (2))
+    ADD (" --shrink=%u", pick (4));
+  if (pick (2))
+    ADD (" --circuitcnf=%u", 1 + pick (2));
+  if (pick (2))
+    ADD (" --circuitprobethreads=%u", 1 + pick (4));
+  if (pick (2))
+    ADD (" --circuitreclearn=%u", pick (4));
+  if (pick (2))
+    ADD (" --subsumeinc=%u", pick (2));
+  if (!pick (4))
+    ADD (" --circuitcube=%u --circuitcubethreads=%u", 1 + pick (3),
+         1 + pick (3));
+  static const char *toggles[] = {"decompose", "deduplicate", "elim",
+                                  "minimize",  "probe",       "subsume",
+                                  "ternary",   "transred"};
+  for (unsigned i = 0; i < sizeof toggles / sizeof *toggles; i++)
+    if (!pick (4))
+      ADD (" --%s=0", toggles[i]);
+#undef ADD
+}
+
+static unsigned number (const char *arg) {
+  char *end;
+  const unsigned long res = strtoul (arg, &end, 10);
+  if (!*arg || *end || res > 0xffffffffu)
+    die ("invalid number '%s'", arg);
+  return res;
+}
+
+static unsigned long long seed_number (const char *arg) {
+  char *end;
+  const unsigned long long res = strtoull (arg, &end, 10);
+  if (!*arg || *end)
+    die ("invalid seed '%s'", arg);
+  return res;
+}
+
+int main (int argc, char **argv) {
+  unsigned long long seed = (unsigned long long) time (0) * 1000003ull +
+                            (unsigned long long) getpid ();
+  unsigned runs = 0;
+  int i;
+  for (i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (!strcmp (arg, "-h")) {
+      fputs (usage, stdout);
+      return 0;
+    } else if (!strcmp (arg, "-q"))
+      quiet = 1;
+    else if (!strcmp (arg, "-k"))
+      keep_going = 1;
+    else if (!strcmp (arg, "-f"))
+      fixed = 1;
+    else if (!strcmp (arg, "--")) {
+      i++;
+      break;
+    } else if (i + 1 == argc || arg[0] != '-' || !arg[1] || arg[2])
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (arg[1] == 's')
+      seed = seed_number (argv[++i]);
+    else if (arg[1] == 'n')
+      runs = number (argv[++i]);
+    else if (arg[1] == 'b')
+      solver = argv[++i];
+    else if (arg[1] == 'm')
+      modes = argv[++i];
+    else if (arg[1] == 't')
+      time_limit = number (argv[++i]);
+    else if (arg[1] == 'p')
+      prefix = argv[++i];
+    else
+      die ("invalid option '%s' (try '-h')", arg);
+  }
+  size_t len = 0;
+  for (; i < argc; i++)
+    len += snprintf (extra + len, sizeof extra - len, " %s", argv[i]);
+  if (!*modes || strspn (modes, "123") != strlen (modes))
+    die ("invalid modes '%s'", modes);
+  if (access (solver, X_OK))
+    die ("can not execute solver '%s'", solver);
+
+  const char *tmpdir = getenv ("TMPDIR");
+  if (!tmpdir)
+    tmpdir = "/tmp";
+  snprintf (aag_path, sizeof aag_path, "%s/aigfuzz-%d.aag", tmpdir,
+            (int) getpid ());
+  snprintf (cnf_path, sizeof cnf_path, "%s/aigfuzz-%d.cnf", tmpdir,
+            (int) getpid ());
+
+  msg ("solver '%s' modes '%s' first seed %llu", solver, modes, seed);
+  unsigned failed = 0, run;
+  for (run = 0; !runs || run < runs; run++, seed++) {
+    seed_rng (seed);
+    AIG *aig = generate ();
+    randomize_options ();
+    int failure = NONE;
+    char mode = 0;
+    for (const char *p = modes; !failure && *p; p++)
+      failure = check (aig, mode = *p);
+    if (!quiet && isatty (1))
+      printf ("\raigfuzz: run %u seed %llu %u failed", run + 1, seed,
+              failed),
+          fflush (stdout);
+    if (failure) {
+      failed++;
+      if (!quiet && isatty (1))
+        fputc ('\n', stdout);
+      char path[512];
+      snprintf (path, sizeof path, "%s%llu.aag", prefix, seed);
+      write_aag (aig, path);
+      msg ("seed %llu %s failure in mode %c with options '%s%s'", seed,
+           failures[failure], mode, options, extra);
+      msg ("written failing AIG to '%s' (%u inputs, %u gates)", path,
+           aig->inputs, aig->num_gates);
+      if (failure != REFERENCE) {
+        aig = shrink (aig, mode, failure);
+        snprintf (path, sizeof path, "%s%llu-red.aag", prefix, seed);
+        write_aag (aig, path);
+        msg ("written reduced AIG to '%s' (%u inputs, %u gates)", path,
+             aig->inputs, aig->num_gates);
+      }
+    }
+    delete_aig (aig);
+    if (failure && !keep_going) {
+      run++;
+      break;
+    }
+  }
+  if (!quiet && isatty (1))
+    fputc ('\n', stdout);
+  unlink (aag_path), unlink (cnf_path);
+  msg ("%u runs, %u failed", run, failed);
+  return failed != 0;
+}
@@ -0,0 +1,373 @@
+/*
+ * Generator of parameterized AIG families in ASCII AIGER format for
+ * benchmarking the circuit engine.  The result is written to '<stdout>'.
+ * All families are deterministic given their parameters (and seed).
+ *
+ *   aiggen adder <bits>                       adder miter (UNSAT)
+ *   aiggen mult <bits>                        multiplier miter (UNSAT)
+ *   aiggen parity <inputs>                    parity chain miter (UNSAT)
+ *   aiggen random <inputs> <gates> <depth> <fanout> <seed>
+ *   aiggen planted <inputs> <gates> <depth> <fanout> <seed>   (SAT)
+ *
+ * For 'random' and 'planted' the gates are placed in 'depth' levels and the
+ * inputs of a gate are taken from the previous level with a probability of
+ * one half and otherwise from all earlier nodes.  With probability
+ * 'fanout' percent an already used node is reused, which increases
+ * reconvergent fanout.  The single output of 'random' is the conjunction of
+ * (at most four) nodes of the last level.  In 'planted' a random input
+ * assignment is fixed and the output is the conjunction of a random sample
+ * of node literals, each with the phase it has under this assignment, which
+ * makes the instance satisfiable.
+ */
+#include <assert.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void die (const char *msg, ...) {
+  va_list ap;
+  fputs ("*** aiggen: ", stderr);
+  va_start (ap, msg);
+  vfprintf (stderr, msg, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+/*------------------------------------------------------------------------*/
+
+typedef struct Gate {
+  unsigned lhs, rhs0, rhs1;
+} Gate;
+
+static unsigned num_inputs, max_var;
+static unsigned *outputs, num_outputs, size_outputs;
+static Gate *gates;
+static unsigned num_gates, size_gates;
+
+static unsigned new_input (void) {
+  assert (!num_gates);
+  num_inputs++;
+  return 2 * ++max_var;
+}
+
+static unsigned and2 (unsigned a, unsigned b) {
+  if (num_gates == size_gates) {
+    size_gates = size_gates ? 2 * size_gates : 1024;
+    gates = realloc (gates, size_gates * sizeof *gates);
+    if (!gates)
+      die ("out of memory");
+  }
+  Gate *g = gates + num_gates++;
+  g->lhs = 2 * ++max_var;
+  g->rhs0 = a > b ? a : b;
+  g->rhs1 = a > b ? b : a;
+  return g->lhs;
+}
+
+static unsigned not1 (unsigned a) { return a ^ 1; }
+
+static unsigned or2 (unsigned a, unsigned b) {
+  return not1 (and2 (not1 (a), not1 (b)));
+}
+
+static unsigned xor2 (unsigned a, unsigned b) {
+  return and2 (not1 (and2 (a, b)), not1 (and2 (not1 (a), not1 (b))));
+}
+
+static void output (unsigned lit) {
+  if (num_outputs == size_outputs) {
+    size_outputs = size_outputs ? 2 * size_outputs : 16;
+    outputs = realloc (outputs, size_outputs * sizeof *outputs);
+    if (!outputs)
+      die ("out of memory");
+  }
+  outputs[num_outputs++] = lit;
+}
+
+static void print (void) {
+  printf ("aag %u %u 0 %u %u\n", max_var, num_inputs, num_outputs,
+          num_gates);
+  for (unsigned i = 1; i <= num_inputs; i++)
+    printf ("%u\n", 2 * i);
+  for (unsigned i = 0; i < num_outputs; i++)
+    printf ("%u\n", outputs[i]);
+  for (unsigned i = 0; i < num_gates; i++)
+    printf ("%u %u %u\n", gates[i].lhs, gates[i].rhs0, gates[i].rhs1);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Disjunction of the pairwise XORs of two vectors.
+
+static unsigned miter (const unsigned *a, const unsigned *b, unsigned n) {
+  unsigned res = xor2 (a[0], b[0]);
+  for (unsigned i = 1; i < n; i++)
+    res = or2 (res, xor2 (a[i], b[i]));
+  return res;
+}
+
+// Sum 'n + 1' bits of 'a + b' with two structurally different adders.
+
+static void ripple_adder (const unsigned *a, const unsigned *b, unsigned n,
+                          unsigned *sum) {
+  unsigned carry = and2 (a[0], b[0]);
+  sum[0] = xor2 (a[0], b[0]);
+  for (unsigned i = 1; i < n; i++) {
+    const unsigned t = xor2 (a[i], b[i]);
+    sum[i] = xor2 (t, carry);
+    carry = or2 (and2 (a[i], b[i]), and2 (carry, t));
+  }
+  sum[n] = carry;
+}
+
+static void majority_adder (const unsigned *a, const unsigned *b,
+                            unsigned n, unsigned *sum) {
+  unsigned carry = and2 (b[0], a[0]);
+  sum[0] = xor2 (b[0], a[0]);
+  for (unsigned i = 1; i < n; i++) {
+    sum[i] = xor2 (a[i], xor2 (b[i], carry));
+    carry =
+        or2 (or2 (and2 (a[i], b[i]), and2 (a[i], carry)), and2 (b[i], carry));
+  }
+  sum[n] = carry;
+}
+
+static void adder (unsigned n) {
+  unsigned *a = malloc (n * sizeof *a), *b = malloc (n * sizeof *b);
+  unsigned *s = malloc ((n + 1) * sizeof *s);
+  unsigned *t = malloc ((n + 1) * sizeof *t);
+  for (unsigned i = 0; i < n; i++)
+    a[i] = new_input (), b[i] = new_input ();
+  ripple_adder (a, b, n, s);
+  majority_adder (a, b, n, t);
+  output (miter (s, t, n + 1));
+  free (a), free (b), free (s), free (t);
+}
+
+// Array multiplier accumulating shifted partial products row by row.  The
+// accumulator grows by the carries, thus it might end up with more than
+// '2 * bits' bits (which are then always false).
+
+static void add_shifted (unsigned *acc, unsigned *width, const unsigned *row,
+                         unsigned n, unsigned shift) {
+  const unsigned end = *width > shift + n ? *width : shift + n;
+  unsigned carry = 0, pos;
+  for (pos = shift; pos < end; pos++) {
+    const int have_x = pos < *width, have_y = pos - shift < n;
+    unsigned sum;
+    if (have_x && have_y) {
+      const unsigned x = acc[pos], y = row[pos - shift];
+      const unsigned t = xor2 (x, y);
+      if (carry) {
+        sum = xor2 (t, carry);
+        carry = or2 (and2 (x, y), and2 (carry, t));
+      } else
+        sum = t, carry = and2 (x, y);
+    } else {
+      const unsigned z = have_x ? acc[pos] : row[pos - shift];
+      if (carry)
+        sum = xor2 (z, carry), carry = and2 (z, carry);
+      else
+        sum = z;
+    }
+    acc[pos] = sum;
+  }
+  if (carry)
+    acc[pos++] = carry;
+  *width = pos;
+}
+
+static unsigned multiplier (const unsigned *a, const unsigned *b,
+                            unsigned n, unsigned *product) {
+  unsigned *row = malloc (n * sizeof *row);
+  unsigned width = n;
+  for (unsigned j = 0; j < n; j++)
+    product[j] = and2 (a[j], b[0]);
+  for (unsigned i = 1; i < n; i++) {
+    for (unsigned j = 0; j < n; j++)
+      row[j] = and2 (a[j], b[i]);
+    add_shifted (product, &width, row, n, i);
+  }
+  free (row);
+  return width;
+}
+
+static void mult (unsigned n) {
+  unsigned *a = malloc (n * sizeof *a), *b = malloc (n * sizeof *b);
+  unsigned *p = malloc (4 * n * sizeof *p), *q = malloc (4 * n * sizeof *q);
+  for (unsigned i = 0; i < n; i++)
+    a[i] = new_input ();
+  for (unsigned i = 0; i < n; i++)
+    b[i] = new_input ();
+  const unsigned width = multiplier (a, b, n, p);
+  const unsigned other = multiplier (b, a, n, q);
+  assert (width == other), (void) other;
+  output (miter (p, q, width));
+  free (a), free (b), free (p), free (q);
+}
+
+// Parity as a linear chain versus a balanced tree.
+
+static void parity (unsigned n) {
+  unsigned *x = malloc (n * sizeof *x);
+  for (unsigned i = 0; i < n; i++)
+    x[i] = new_input ();
+  unsigned chain = x[0];
+  for (unsigned i = 1; i < n; i++)
+    chain = xor2 (chain, x[i]);
+  for (unsigned m = n; m > 1; m = (m + 1) / 2) {
+    for (unsigned i = 0; i + 1 < m; i += 2)
+      x[i / 2] = xor2 (x[i], x[i + 1]);
+    if (m & 1)
+      x[m / 2] = x[m - 1];
+  }
+  output (miter (&chain, x, 1));
+  free (x);
+}
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t state;
+
+static uint64_t next (void) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static unsigned pick (unsigned n) { return next () % n; }
+
+// Random levelized AIG, where 'nodes' gets all input and gate literals.
+
+static unsigned random_levels (unsigned inputs, unsigned num, unsigned depth,
+                               unsigned fanout, unsigned *nodes,
+                               unsigned *last) {
+  unsigned count = 0;
+  for (unsigned i = 0; i < inputs; i++)
+    nodes[count++] = new_input ();
+  unsigned *used = malloc (2 * num * sizeof *used), num_used = 0;
+  unsigned begin = 0, end = count;
+  for (unsigned level = 0; level < depth; level++) {
+    const unsigned width =
+        num / depth + (level < num % depth ? 1 : 0);
+    for (unsigned k = 0; k < width; k++) {
+      unsigned lits[2];
+      for (unsigned l = 0; l < 2; l++) {
+        unsigned node;
+        if (num_used && pick (100) < fanout)
+          node = used[pick (num_used)];
+        else if (pick (2))
+          node = nodes[begin + pick (end - begin)];
+        else
+          node = nodes[pick (end)];
+        used[num_used++] = node;
+        lits[l] = node ^ (unsigned) (next () & 1);
+      }
+      while ((lits[0] >> 1) == (lits[1] >> 1))
+        lits[1] = nodes[pick (end)] ^ (unsigned) (next () & 1);
+      nodes[count++] = and2 (lits[0], lits[1]);
+    }
+    if (width)
+      begin = end, end = count;
+  }
+  free (used);
+  *last = begin;
+  return count;
+}
+
+static void random_aig (unsigned inputs, unsigned num, unsigned depth,
+                        unsigned fanout) {
+  unsigned *nodes = malloc ((inputs + num) * sizeof *nodes), last;
+  const unsigned count =
+      random_levels (inputs, num, depth, fanout, nodes, &last);
+  unsigned res = nodes[last];
+  for (unsigned i = last + 1; i < count && i < last + 4; i++)
+    res = and2 (res, nodes[i]);
+  output (res);
+  free (nodes);
+}
+
+static void planted (unsigned inputs, unsigned num, unsigned depth,
+                     unsigned fanout) {
+  unsigned *nodes = malloc ((inputs + num) * sizeof *nodes), last;
+  const unsigned count =
+      random_levels (inputs, num, depth, fanout, nodes, &last);
+  (void) last;
+
+  // Simulate the planted assignment.
+  //
+  char *value = calloc (max_var + 1, 1);
+  for (unsigned i = 1; i <= num_inputs; i++)
+    value[i] = next () & 1;
+  for (unsigned i = 0; i < num_gates; i++) {
+    const Gate *g = gates + i;
+    const int a = value[g->rhs0 / 2] ^ (g->rhs0 & 1);
+    const int b = value[g->rhs1 / 2] ^ (g->rhs1 & 1);
+    value[g->lhs / 2] = a & b;
+  }
+
+  // Conjunction of sampled node literals true under the assignment.
+  //
+  const unsigned samples = count / 16 + 1;
+  unsigned res = 0;
+  for (unsigned i = 0; i < samples; i++) {
+    const unsigned node = nodes[inputs + pick (count - inputs)];
+    const unsigned lit = node ^ (unsigned) !value[node / 2];
+    res = res ? and2 (res, lit) : lit;
+  }
+  output (res);
+  free (nodes), free (value);
+}
+
+/*------------------------------------------------------------------------*/
+
+static unsigned number (const char *arg) {
+  char *end;
+  const unsigned long res = strtoul (arg, &end, 10);
+  if (!*arg || *end || res > (1ul << 24))
+    die ("invalid number '%s'", arg);
+  return res;
+}
+
+int main (int argc, char **argv) {
+  if (argc < 3)
+    die ("usage: aiggen adder|mult|parity|random|planted <arg> ...");
+  const char *family = argv[1];
+  if (!strcmp (family, "adder") && argc == 3) {
+    const unsigned n = number (argv[2]);
+    if (!n)
+      die ("expected positive number of bits");
+    adder (n);
+  } else if (!strcmp (family, "mult") && argc == 3) {
+    const unsigned n = number (argv[2]);
+    if (n < 2)
+      die ("expected at least two bits");
+    mult (n);
+  } else if (!strcmp (family, "parity") && argc == 3) {
+    const unsigned n = number (argv[2]);
+    if (n < 2)
+      die ("expected at least two inputs");
+    parity (n);
+  } else if ((!strcmp (family, "random") || !strcmp (family, "planted")) &&
+             argc == 7) {
+    const unsigned inputs = number (argv[2]), num = number (argv[3]);
+    const unsigned depth = number (argv[4]), fanout = number (argv[5]);
+    state = 0x9e3779b97f4a7c15ull ^ number (argv[6]);
+    next ();
+    if (inputs < 2 || !num || !depth || depth > num || fanout > 100)
+      die ("invalid random parameters");
+    if (family[0] == 'r')
+      random_aig (inputs, num, depth, fanout);
+    else
+      planted (inputs, num, depth, fanout);
+  } else
+    die ("invalid arguments for family '%s' (try without arguments)",
+         family);
+  print ();
+  free (gates), free (outputs);
+  return 0;
+}
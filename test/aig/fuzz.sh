@@ -0,0 +1,72 @@
+#!/bin/sh
+
+#--------------------------------------------------------------------------#
+
+die () {
+  cecho "${HIDE}test/aig/fuzz.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/aig/fuzz.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/aig ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -x "$CADICALBUILD/cadical" ] || \
+  die "can not find '$CADICALBUILD/cadical' (run 'make' first)"
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "AIG differential fuzzing in '$CADICALBUILD'"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+make -C $CADICALBUILD
+res=$?
+[ $res = 0 ] || exit $res
+
+#--------------------------------------------------------------------------#
+
+aigfuzz="$CADICALBUILD/aigfuzz"
+
+if [ ! -f $aigfuzz -o ../test/aig/aigfuzz.c -nt $aigfuzz ]
+then
+  cmd="cc -O -o $aigfuzz ../test/aig/aigfuzz.c"
+  cecho "$cmd"
+  $cmd || die "compiling '../test/aig/aigfuzz.c' failed"
+fi
+
+[ x"$AIGFUZZRUNS" = x ] && AIGFUZZRUNS=1000
+
+msg "generating and checking $AIGFUZZRUNS random AIGs"
+msg "changing to build directory '$CADICALBUILD' and running"
+cd $CADICALBUILD
+
+cmd="./aigfuzz -s 42 -n $AIGFUZZRUNS -k -p test-aig-fuzz-"
+cecho "${HILITE}$cmd${NORMAL}"
+$cmd
+res=$?
+
+if [ $res = 0 ]
+then
+  msg "${GOOD}all runs succeeded${NORMAL}"
+else
+  msg "${BAD}some runs failed${NORMAL}"
+fi
+
+msg "consider to run 'aigfuzz' for longer (with '-n 0')"
+
+exit $res
@@ -0,0 +1,216 @@
+#!/bin/sh
+
+#--------------------------------------------------------------------------#
+
+die () {
+  cecho "${HIDE}test/aig/regress.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/aig/regress.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/aig ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -x "$CADICALBUILD/cadical" ] || \
+  die "can not find '$CADICALBUILD/cadical' (run 'make' first)"
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "AIG regression testing in '$CADICALBUILD'"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+make -C $CADICALBUILD
+res=$?
+[ $res = 0 ] || exit $res
+
+#--------------------------------------------------------------------------#
+
+solver="$CADICALBUILD/cadical"
+prefix=$CADICALBUILD/test-aig
+
+ok=0
+failed=0
+
+# Solve '../test/aig/<name>.aag' with the given options and check the exit
+# code.  Further checks on the log '$log' call 'good' or 'bad' afterwards.
+
+run () {
+  test=$1
+  name=$2
+  expected=$3
+  shift 3
+  log=$prefix-$name-$test.log
+  msg "running ${HILITE}'$test'${NORMAL} on '$name'"
+  cecho "$solver \\"
+  cecho "$* ../test/aig/$name.aag"
+  cecho -n "# $expected ..."
+  "$solver" "$@" ../test/aig/$name.aag 1>$log 2>&1
+  res=$?
+  [ $res = $expected ] && return 0
+  bad "actual exit code $res"
+  return 1
+}
+
+good () {
+  cecho " ${GOOD}ok${NORMAL} (exit code $res)"
+  ok=`expr $ok + 1`
+}
+
+bad () {
+  cecho " ${BAD}FAILED${NORMAL} ($*)"
+  failed=`expr $failed + 1`
+}
+
+# Number of input patterns covered by the cubes in the given file.
+
+patterns () {
+  awk '
+function expand (cube,  i) {
+  i = index (cube, "x")
+  if (!i) { covered[cube] = 1; return }
+  expand(substr (cube, 1, i - 1) "0" substr (cube, i + 1))
+  expand(substr (cube, 1, i - 1) "1" substr (cube, i + 1))
+}
+{ expand($0) }
+END { n = 0; for (cube in covered) n++; print n }' $1
+}
+
+#--------------------------------------------------------------------------#
+
+# Checkpoints: interrupted by the conflict limit and resumed.
+
+ckpt=$prefix-mult4.ckpt
+rm -f $ckpt
+if run checkpoint mult4 0 --satsolvermode=1 --circuitckptint=1 -c 150 -k $ckpt
+then
+  if [ -f $ckpt ]
+  then
+    good
+  else
+    bad "no checkpoint '$ckpt' written"
+  fi
+fi
+
+if run resume mult4 20 --satsolvermode=1 -k $ckpt
+then
+  if grep -q '^c resumed circuit checkpoint' $log
+  then
+    good
+  else
+    bad "checkpoint '$ckpt' not resumed"
+  fi
+fi
+
+# Lemma cache: stored by the first and imported by the second run.
+
+cache=$prefix-mult4.cache
+rm -f $cache
+run lemmas mult4 20 --satsolvermode=1 -m $cache && good
+
+if run lemmas-import mult4 20 --satsolvermode=1 -m $cache
+then
+  imported=`awk '/^c lemmacache:/ { print $3; exit }' $log`
+  if [ 0${imported} -gt 0 ]
+  then
+    good
+  else
+    bad "no lemmas imported from '$cache'"
+  fi
+fi
+
+# Bounded model checking: counterexample in AIGER witness format and safe
+# up to an exhausted bound.
+
+if run bmc counter 10 -q
+then
+  witness="`grep -v '^s' $log | tr '\n' ' '`"
+  if [ "$witness" = "1 b0 00 1 1 1 1 . " ]
+  then
+    good
+  else
+    bad "unexpected witness '$witness'"
+  fi
+fi
+
+run bmc-bound counter 20 -q --circuitbmc=2 && good
+
+# Server mode: queries under assumptions (outputs are not asserted).
+
+queries=$prefix-and-server.in
+cat <<EOF > $queries
+solve 1 2
+solve 3
+solve 3 -1
+solve -3 1
+solve 4
+solve -1 -2
+quit
+EOF
+answers="s SATISFIABLE
+v 1 2 3 0
+s SATISFIABLE
+v 1 2 3 0
+s UNSATISFIABLE
+s SATISFIABLE
+v 1 -2 -3 0
+e invalid literal in 'solve 4'
+s SATISFIABLE
+v -1 -2 -3 0"
+if run server and 0 -q --server < $queries
+then
+  if [ "`cat $log`" = "$answers" ]
+  then
+    good
+  else
+    bad "unexpected answers in '$log'"
+  fi
+fi
+
+# AllSAT: cubes cover exactly the satisfying input patterns.
+
+cubes=$prefix-allsat.cubes
+if run enumerate allsat 20 -q -s $cubes
+then
+  covered=`patterns $cubes`
+  if [ $covered = 18 ]
+  then
+    good
+  else
+    bad "cubes cover $covered instead of 18 patterns"
+  fi
+fi
+
+if run enumerate-limit allsat 10 -q --circuitenum=3 -s $cubes
+then
+  lines=`wc -l < $cubes`
+  if [ $lines = 3 ]
+  then
+    good
+  else
+    bad "$lines instead of 3 cubes"
+  fi
+fi
+
+#--------------------------------------------------------------------------#
+
+[ $ok -gt 0 ] && OK="$GOOD"
+[ $failed -gt 0 ] && FAILED="$BAD"
+
+msg "$OK$ok ok$NORMAL, $FAILED$failed failed$NORMAL"
+
+exit $failed
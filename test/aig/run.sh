@@ -0,0 +1,174 @@
+#!/bin/sh
+
+#--------------------------------------------------------------------------#
+
+die () {
+  cecho "${HIDE}test/aig/run.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/aig/run.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/aig ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -x "$CADICALBUILD/cadical" ] || \
+  die "can not find '$CADICALBUILD/cadical' (run 'make' first)"
+
+# Solver modes to compare (1=circuitsat, 2=easysat, 3=cadical), time limit
+# per run in seconds, and whether to include the large instances.
+
+[ x"$AIGMODES" = x ] && AIGMODES="1 2 3"
+[ x"$AIGTIMEOUT" = x ] && AIGTIMEOUT=60
+[ x"$AIGLARGE" = x ] && AIGLARGE=0
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "AIG benchmarking in '$CADICALBUILD'"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+make -C $CADICALBUILD
+res=$?
+[ $res = 0 ] || exit $res
+
+#--------------------------------------------------------------------------#
+
+solver="$CADICALBUILD/cadical"
+aiggen="$CADICALBUILD/aiggen"
+prefix=$CADICALBUILD/test-aig
+json=$prefix.json
+
+if [ ! -f $aiggen -o ../test/aig/aiggen.c -nt $aiggen ]
+then
+  cmd="cc -O -o $aiggen ../test/aig/aiggen.c"
+  cecho "$cmd"
+  $cmd || die "compiling '../test/aig/aiggen.c' failed"
+fi
+
+if command -v timeout >/dev/null 2>&1
+then
+  limit="timeout `expr $AIGTIMEOUT + 10`"
+else
+  limit=""
+fi
+
+#--------------------------------------------------------------------------#
+
+ok=0
+failed=0
+first=yes
+
+echo "[" > $json
+
+value () {
+  awk "/^c $1:/ { print \$3; exit }" $2
+}
+
+bench () {
+  name=$1
+  expected=$2
+  shift 2
+  aag=$prefix-$name.aag
+  $aiggen "$@" > $aag || die "generating '$name' failed"
+  for mode in $AIGMODES
+  do
+    msg "running AIG benchmark ${HILITE}'$name'${NORMAL} in mode $mode"
+    log=$prefix-$name-$mode.log
+    cecho "$solver \\"
+    cecho "--satsolvermode=$mode -t $AIGTIMEOUT $aag"
+    cecho -n "# $expected ..."
+    start=`date +%s%N`
+    $limit "$solver" --satsolvermode=$mode -t $AIGTIMEOUT $aag 1>$log 2>&1
+    res=$?
+    end=`date +%s%N`
+    if [ ! $res = 0 -a ! $res = 10 -a ! $res = 20 ]
+    then
+      cecho " ${BAD}FAILED${NORMAL} (unsupported exit code $res)"
+      failed=`expr $failed + 1`
+    elif [ ! $expected = 0 -a ! $res = 0 -a ! $res = $expected ]
+    then
+      cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+      failed=`expr $failed + 1`
+    else
+      if [ $res = 0 ]
+      then
+        cecho " ${GOOD}ok${NORMAL} (unknown after $AIGTIMEOUT seconds)"
+      else
+        cecho " ${GOOD}ok${NORMAL} (exit code $res)"
+      fi
+      ok=`expr $ok + 1`
+    fi
+    wall=`awk "BEGIN { printf \"%.3f\", ($end - $start) / 1e9 }"`
+    propagations=`value propagations $log`
+    conflicts=`value conflicts $log`
+    rss=`awk '/^c maximum resident set size/ { print $(NF-1); exit }' $log`
+    [ x"$propagations" = x ] && propagations=0
+    [ x"$conflicts" = x ] && conflicts=0
+    [ x"$rss" = x ] && rss=0
+    rate=`awk "BEGIN { printf \"%.0f\", ($wall > 0 ? $propagations / $wall : 0) }"`
+    [ $first = yes ] || echo "," >> $json
+    first=no
+    printf '  {"instance": "%s", "generator": "%s", "mode": %s, ' \
+      "$name" "$*" $mode >> $json
+    printf '"expected": %s, "status": %s, "wall_seconds": %s, ' \
+      $expected $res $wall >> $json
+    printf '"propagations": %s, "propagations_per_second": %s, ' \
+      $propagations $rate >> $json
+    printf '"conflicts": %s, "peak_rss_mb": %s}' \
+      $conflicts $rss >> $json
+  done
+}
+
+#--------------------------------------------------------------------------#
+
+# name, expected exit code (0 if unknown), generator arguments
+
+bench adder16 20 adder 16
+bench adder64 20 adder 64
+bench mult4 20 mult 4
+bench mult6 20 mult 6
+bench parity64 20 parity 64
+bench parity256 20 parity 256
+bench random-small 0 random 16 300 10 20 1
+bench random-medium 0 random 40 3000 20 20 3
+bench random-large 0 random 64 10000 30 20 4
+bench planted-small 10 planted 16 300 10 20 1
+bench planted-medium 10 planted 32 3000 30 30 2
+bench planted-large 10 planted 64 20000 40 30 3
+
+if [ $AIGLARGE = 1 ]
+then
+  bench adder1024 20 adder 1024
+  bench mult7 20 mult 7
+  bench mult8 20 mult 8
+  bench parity4096 20 parity 4096
+  bench random-huge 0 random 128 200000 80 30 5
+  bench planted-huge 10 planted 128 200000 80 30 6
+fi
+
+echo "" >> $json
+echo "]" >> $json
+
+#--------------------------------------------------------------------------#
+
+[ $ok -gt 0 ] && OK="$GOOD"
+[ $failed -gt 0 ] && FAILED="$BAD"
+
+msg "benchmark results written to '$json'"
+msg "$OK$ok ok$NORMAL, $FAILED$failed failed$NORMAL"
+
+exit $failed